@@ -322,6 +322,10 @@ void AppModel::onResetWallet()
     assert(m_assets.use_count() == 1);
     m_assets.reset();
 
+    assert(m_transactions);
+    assert(m_transactions.use_count() == 1);
+    m_transactions.reset();
+
     assert(m_wallet);
     assert(m_wallet.use_count() == 1);
     m_wallet.reset();
@@ -505,7 +509,9 @@ void AppModel::start()
     initSwapClients();
 
     m_wallet = std::make_shared<WalletModel>(m_db, nodeAddrStr, m_walletReactor);
-    m_assets = std::make_shared<AssetsManager>(m_wallet);
+    const QDir walletDir(QString::fromStdString(m_settings.getWalletFolder()));
+    m_assets = std::make_shared<AssetsManager>(m_wallet, walletDir.filePath("assets.cache"));
+    m_transactions = std::make_shared<TransactionsStore>(m_wallet);
 
     if (m_settings.getRunLocalNode())
     {
@@ -555,6 +561,11 @@ AssetsManager::Ptr AppModel::getAssets() const
     return m_assets;
 }
 
+TransactionsStore::Ptr AppModel::getTransactions() const
+{
+    return m_transactions;
+}
+
 MessageManager& AppModel::getMessages()
 {
     return m_messages;
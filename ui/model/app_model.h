@@ -20,6 +20,7 @@
 #include "messages.h"
 #include "node_model.h"
 #include "helpers.h"
+#include "transactions_store.h"
 #include "wallet/core/secstring.h"
 #include "wallet/core/private_key_keeper.h"
 #include "wallet/transactions/swaps/bridges/bitcoin/bridge_holder.h"
@@ -65,6 +66,7 @@ public:
 
     [[nodiscard]] WalletModel::Ptr getWalletModel() const;
     [[nodiscard]] AssetsManager::Ptr getAssets() const;
+    [[nodiscard]] TransactionsStore::Ptr getTransactions() const;
     [[nodiscard]] WalletSettings& getSettings() const;
 
     MessageManager& getMessages();
@@ -112,6 +114,7 @@ private:
     NodeModel m_nodeModel;
     WalletSettings& m_settings;
     AssetsManager::Ptr m_assets;
+    TransactionsStore::Ptr m_transactions;
     MessageManager m_messages;
     ECC::NoLeak<ECC::uintBig> m_passwordHash;
     beam::io::Reactor::Ptr m_walletReactor;
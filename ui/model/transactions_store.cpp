@@ -0,0 +1,223 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "transactions_store.h"
+#include <algorithm>
+
+namespace
+{
+    template <typename Index, typename Key>
+    void eraseFromIndex(Index& index, const Key& key, const beam::wallet::TxID& txId)
+    {
+        auto it = index.find(key);
+        if (it != index.end())
+        {
+            it->second.erase(txId);
+            if (it->second.empty())
+            {
+                index.erase(it);
+            }
+        }
+    }
+}
+
+TransactionsView::TransactionsView(Types types)
+    : _types(std::move(types))
+{
+}
+
+const TransactionsView::Types& TransactionsView::types() const
+{
+    return _types;
+}
+
+bool TransactionsView::accepts(beam::wallet::TxType type) const
+{
+    return _types.find(type) != _types.end();
+}
+
+TransactionsStore::TransactionsStore(WalletModel::Ptr wallet)
+    : _wallet(std::move(wallet))
+{
+    connect(_wallet.get(), &WalletModel::transactionsChanged, this, &TransactionsStore::onTransactionsChanged);
+}
+
+void TransactionsStore::load()
+{
+    if (!_requested)
+    {
+        _requested = true;
+        _wallet->getAsync()->getTransactions();
+    }
+}
+
+bool TransactionsStore::isLoaded() const
+{
+    return _loaded;
+}
+
+const beam::wallet::TxDescription* TransactionsStore::find(const beam::wallet::TxID& txId) const
+{
+    const auto it = _txs.find(txId);
+    return it != _txs.end() ? &it->second : nullptr;
+}
+
+TransactionsStore::TxList TransactionsStore::getAll() const
+{
+    TxList result;
+    result.reserve(_txs.size());
+    for (const auto& p : _txs)
+    {
+        result.push_back(p.second);
+    }
+    return result;
+}
+
+TransactionsStore::TxList TransactionsStore::getByType(const TransactionsView::Types& types) const
+{
+    TxList result;
+    for (auto type : types)
+    {
+        const auto it = _byType.find(type);
+        if (it != _byType.end())
+        {
+            auto part = collect(it->second);
+            result.insert(result.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+        }
+    }
+    return result;
+}
+
+TransactionsView::Ptr TransactionsStore::makeView(std::initializer_list<beam::wallet::TxType> types)
+{
+    auto view = std::make_shared<TransactionsView>(TransactionsView::Types(types));
+    _views.push_back(view);
+    return view;
+}
+
+TransactionsStore::TxList TransactionsStore::collect(const TxIDs& ids) const
+{
+    TxList result;
+    result.reserve(ids.size());
+    for (const auto& id : ids)
+    {
+        const auto it = _txs.find(id);
+        if (it != _txs.end())
+        {
+            result.push_back(it->second);
+        }
+    }
+    return result;
+}
+
+void TransactionsStore::put(const beam::wallet::TxDescription& tx)
+{
+    // indexed fields never change for the existing tx, but be safe
+    erase(tx.m_txId);
+
+    _txs[tx.m_txId] = tx;
+    _byType[tx.m_txType].insert(tx.m_txId);
+}
+
+void TransactionsStore::erase(const beam::wallet::TxID& txId)
+{
+    const auto it = _txs.find(txId);
+    if (it == _txs.end())
+    {
+        return;
+    }
+
+    const auto& tx = it->second;
+    eraseFromIndex(_byType, tx.m_txType, txId);
+    _txs.erase(it);
+}
+
+void TransactionsStore::onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items)
+{
+    using namespace beam::wallet;
+
+    // take types before removed txs are dropped from the cache
+    std::vector<TxType> types;
+    types.reserve(items.size());
+    for (const auto& tx : items)
+    {
+        const auto* cached = find(tx.m_txId);
+        types.push_back(cached ? cached->m_txType : tx.m_txType);
+    }
+
+    switch (action)
+    {
+    case ChangeAction::Reset:
+        _txs.clear();
+        _byType.clear();
+        for (const auto& tx : items)
+        {
+            put(tx);
+        }
+        _loaded = true;
+        _requested = true;
+        break;
+
+    case ChangeAction::Added:
+    case ChangeAction::Updated:
+        for (const auto& tx : items)
+        {
+            put(tx);
+        }
+        break;
+
+    case ChangeAction::Removed:
+        for (const auto& tx : items)
+        {
+            erase(tx.m_txId);
+        }
+        break;
+
+    default:
+        assert(false && "Unexpected action");
+        break;
+    }
+
+    emit transactionsChanged(action, items);
+    notifyViews(action, items, types);
+}
+
+void TransactionsStore::notifyViews(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items, const std::vector<beam::wallet::TxType>& types)
+{
+    _views.erase(std::remove_if(_views.begin(), _views.end(), [](const auto& view) { return view.expired(); }), _views.end());
+
+    // a slot may drop its view, keep them all alive while notifying
+    std::vector<TransactionsView::Ptr> views;
+    views.reserve(_views.size());
+    for (const auto& view : _views)
+    {
+        views.push_back(view.lock());
+    }
+
+    for (const auto& view : views)
+    {
+        std::vector<beam::wallet::TxDescription> matched;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (view->accepts(types[i]))
+            {
+                matched.push_back(items[i]);
+            }
+        }
+
+        if (!matched.empty() || action == beam::wallet::ChangeAction::Reset)
+        {
+            emit view->transactionsChanged(action, matched);
+        }
+    }
+}
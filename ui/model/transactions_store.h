@@ -0,0 +1,91 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <QObject>
+#include <map>
+#include <set>
+#include <initializer_list>
+#include "wallet_model.h"
+
+// Transactions of the given types out of the store.
+// The store filters every change once and emits only the matching part here,
+// Reset is always emitted, even if nothing matches.
+class TransactionsView : public QObject
+{
+    Q_OBJECT
+public:
+    using Ptr = std::shared_ptr<TransactionsView>;
+    using Types = std::set<beam::wallet::TxType>;
+
+    explicit TransactionsView(Types types);
+
+    [[nodiscard]] const Types& types() const;
+    [[nodiscard]] bool accepts(beam::wallet::TxType type) const;
+
+signals:
+    void transactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items);
+
+private:
+    Types _types;
+};
+
+// UI side cache of the transactions history.
+// History is fetched from the wallet db once and then kept in sync
+// with wallet notifications, view models take their data from here.
+class TransactionsStore : public QObject
+{
+    Q_OBJECT
+public:
+    using Ptr = std::shared_ptr<TransactionsStore>;
+    using TxList = std::vector<beam::wallet::TxDescription>;
+
+    explicit TransactionsStore(WalletModel::Ptr wallet);
+    ~TransactionsStore() override = default;
+
+    // Requests history from the wallet only if it has never been requested
+    void load();
+    [[nodiscard]] bool isLoaded() const;
+
+    [[nodiscard]] const beam::wallet::TxDescription* find(const beam::wallet::TxID& txId) const;
+    [[nodiscard]] TxList getAll() const;
+    [[nodiscard]] TxList getByType(const TransactionsView::Types& types) const;
+
+    // Creates a view which is notified about changes of the given types only.
+    // The store doesn't own views, a view lives while its consumer holds it.
+    [[nodiscard]] TransactionsView::Ptr makeView(std::initializer_list<beam::wallet::TxType> types);
+
+signals:
+    // Emitted after the cache has been updated, carries transactions of all types
+    void transactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items);
+
+private slots:
+    void onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items);
+
+private:
+    typedef std::set<beam::wallet::TxID> TxIDs;
+
+    void put(const beam::wallet::TxDescription& tx);
+    void erase(const beam::wallet::TxID& txId);
+    TxList collect(const TxIDs& ids) const;
+    void notifyViews(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items, const std::vector<beam::wallet::TxType>& types);
+
+    WalletModel::Ptr _wallet;
+    bool _requested = false;
+    bool _loaded = false;
+
+    std::map<beam::wallet::TxID, beam::wallet::TxDescription> _txs;
+    std::map<beam::wallet::TxType, TxIDs> _byType;
+    std::vector<std::weak_ptr<TransactionsView>> _views;
+};
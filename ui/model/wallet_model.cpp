@@ -257,7 +257,6 @@ void WalletModel::onExportDataToJson(const std::string& data)
 
 void WalletModel::onExportTxHistoryToCsv(const std::string& data)
 {
-    emit txHistoryExportedToCsv(QString::fromStdString(data));
 }
 
 void WalletModel::onNodeConnectionChanged(bool isNodeConnected)
@@ -440,7 +439,36 @@ bool WalletModel::hasShielded(beam::Asset::ID id) const
 
 void WalletModel::onWalletStatusInternal(const beam::wallet::WalletStatus& newStatus)
 {
+    const auto sameTotals = [](const auto& l, const auto& r)
+    {
+        return l.available == r.available && l.maturing == r.maturing && l.maturingMP == r.maturingMP &&
+               l.receiving == r.receiving && l.receivingChange == r.receivingChange &&
+               l.receivingIncoming == r.receivingIncoming && l.sending == r.sending && l.shielded == r.shielded;
+    };
+
+    // GetStatus gives zero totals for an absent asset
+    std::set<beam::Asset::ID> changed;
+    for (const auto& status: newStatus.all)
+    {
+        if (!sameTotals(status.second, m_status.GetStatus(status.first)))
+        {
+            changed.insert(status.first);
+        }
+    }
+    for (const auto& status: m_status.all)
+    {
+        if (!newStatus.all.count(status.first) && !sameTotals(status.second, newStatus.GetStatus(status.first)))
+        {
+            changed.insert(status.first);
+        }
+    }
+
     m_status = newStatus;
+
+    if (!changed.empty())
+    {
+        emit assetsStatusChanged(changed);
+    }
     emit walletStatusChanged();
 }
 
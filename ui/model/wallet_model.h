@@ -68,6 +68,8 @@ signals:
 
     // Public Signal
     void walletStatusChanged();
+    // assets whose totals differ from the previous status, emitted before walletStatusChanged
+    void assetsStatusChanged(const std::set<beam::Asset::ID>& assets);
     void assetInfoChanged(beam::Asset::ID assetId, const beam::wallet::WalletAsset& info);
     void iwtCallResult(const QString& callId, boost::any);
 
@@ -99,7 +101,6 @@ signals:
     void hideTrezorMessage();
     void showTrezorError(const QString& error);
 #endif
-    void txHistoryExportedToCsv(const QString& data);
 
     void exchangeRatesUpdate(const std::vector<beam::wallet::ExchangeRate>&);
     void notificationsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::Notification>&);
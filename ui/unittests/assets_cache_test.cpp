@@ -0,0 +1,111 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <QtTest>
+#include <QBuffer>
+#include <QDataStream>
+#include "viewmodel/wallet/assets_cache.h"
+
+namespace
+{
+    std::shared_ptr<beam::wallet::WalletAsset> makeAsset(beam::Asset::ID id, beam::Height lockHeight, const std::string& meta)
+    {
+        auto asset = std::make_shared<beam::wallet::WalletAsset>();
+        asset->m_ID = id;
+        asset->m_LockHeight = lockHeight;
+        asset->m_RefreshHeight = lockHeight + 100;
+        asset->m_Metadata.m_Value.assign(meta.begin(), meta.end());
+        asset->m_Metadata.UpdateHash();
+        return asset;
+    }
+
+    QByteArray write(const CachedAssets& assets)
+    {
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        writeAssetsCache(buffer, assets);
+        return data;
+    }
+
+    CachedAssets read(QByteArray data)
+    {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        return readAssetsCache(buffer);
+    }
+
+    // header is magic, version and count, 4 bytes each
+    void setVersion(QByteArray& data, quint32 version)
+    {
+        QDataStream out(&data, QIODevice::ReadWrite);
+        out.device()->seek(4);
+        out << version;
+    }
+}
+
+class AssetsCacheTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip()
+    {
+        const CachedAssets assets = {
+            makeAsset(1, 1000, "STD:SCH_VER=1;N=Asset One;SN=ONE;UN=ONE;NTHUN=GROTH"),
+            makeAsset(7, 2000, ""),
+        };
+
+        const auto loaded = read(write(assets));
+
+        QCOMPARE(int(loaded.size()), 2);
+        for (size_t i = 0; i < assets.size(); ++i)
+        {
+            QCOMPARE(loaded[i]->m_ID, assets[i]->m_ID);
+            QCOMPARE(loaded[i]->m_LockHeight, assets[i]->m_LockHeight);
+            QCOMPARE(loaded[i]->m_RefreshHeight, assets[i]->m_RefreshHeight);
+            QVERIFY(loaded[i]->m_Metadata.m_Value == assets[i]->m_Metadata.m_Value);
+            QVERIFY(loaded[i]->m_Metadata.m_Hash == assets[i]->m_Metadata.m_Hash);
+        }
+    }
+
+    void emptyAndForeignFilesGiveNothing()
+    {
+        QVERIFY(read(QByteArray()).empty());
+        QVERIFY(read(QByteArray("not an asset cache at all")).empty());
+        QVERIFY(read(write({})).empty());
+    }
+
+    void otherVersionsAreIgnored()
+    {
+        auto data = write({makeAsset(1, 1000, "meta")});
+        setVersion(data, 2);
+
+        QVERIFY(read(data).empty());
+    }
+
+    void damagedTailIsDropped()
+    {
+        const auto data = write({makeAsset(1, 1000, "first"), makeAsset(2, 2000, "second")});
+
+        const auto loaded = read(data.left(data.size() - 3));
+
+        QCOMPARE(int(loaded.size()), 1);
+        QCOMPARE(loaded[0]->m_ID, beam::Asset::ID(1));
+    }
+};
+
+QTEST_APPLESS_MAIN(AssetsCacheTest)
+
+#include "assets_cache_test.moc"
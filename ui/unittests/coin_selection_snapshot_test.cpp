@@ -0,0 +1,137 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <QtTest>
+#include <limits>
+#include "viewmodel/coin_selection_snapshot.h"
+
+using beam::Amount;
+using beam::wallet::ChangeAction;
+using beam::wallet::Coin;
+using beam::wallet::ShieldedCoin;
+
+namespace
+{
+    const beam::Asset::ID kAsset = 5;
+
+    Coin makeCoin(uint64_t idx, Amount amount, beam::Asset::ID assetId = beam::Asset::s_BeamID)
+    {
+        Coin coin;
+        coin.m_ID.m_Idx = idx;
+        coin.m_ID.m_Value = amount;
+        coin.m_ID.m_AssetID = assetId;
+        coin.m_status = Coin::Available;
+        return coin;
+    }
+
+    ShieldedCoin makeShielded(beam::TxoID id, Amount amount)
+    {
+        ShieldedCoin coin;
+        coin.m_TxoID = id;
+        coin.m_CoinID.m_Value = amount;
+        coin.m_CoinID.m_AssetID = beam::Asset::s_BeamID;
+        coin.m_Status = ShieldedCoin::Available;
+        return coin;
+    }
+}
+
+class CoinSelectionSnapshotTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void beamTakesLargestCoinsFirst()
+    {
+        CoinSelectionSnapshot coins;
+        coins.applyNormal(ChangeAction::Reset, {makeCoin(1, 50), makeCoin(2, 30), makeCoin(3, 20)});
+
+        // 60 + 10 fee is covered by 50 + 30
+        auto res = coins.calculate(60, beam::Asset::s_BeamID, 10);
+        QVERIFY(res.isEnough);
+        QCOMPARE(res.fee, Amount(10));
+        QCOMPARE(res.changeBeam, Amount(10));
+        QCOMPARE(res.changeAsset, Amount(0));
+        QCOMPARE(res.maxAmount, Amount(90));
+
+        res = coins.calculate(95, beam::Asset::s_BeamID, 10);
+        QVERIFY(!res.isEnough);
+        QCOMPARE(res.changeBeam, Amount(0));
+        QCOMPARE(res.maxAmount, Amount(90));
+    }
+
+    void assetFeeIsPaidInBeams()
+    {
+        CoinSelectionSnapshot coins;
+        coins.applyNormal(ChangeAction::Reset, {makeCoin(1, 40, kAsset), makeCoin(2, 25, kAsset), makeCoin(3, 7)});
+
+        auto res = coins.calculate(50, kAsset, 5);
+        QVERIFY(res.isEnough);
+        QCOMPARE(res.changeAsset, Amount(15));
+        QCOMPARE(res.changeBeam, Amount(2));
+        QCOMPARE(res.maxAmount, Amount(65));
+
+        // enough of the asset, not enough beams for the fee
+        res = coins.calculate(50, kAsset, 10);
+        QVERIFY(!res.isEnough);
+        QCOMPARE(res.changeAsset, Amount(15));
+        QCOMPARE(res.changeBeam, Amount(0));
+    }
+
+    void changesAreApplied()
+    {
+        CoinSelectionSnapshot coins;
+        coins.applyNormal(ChangeAction::Reset, {makeCoin(1, 50), makeCoin(2, 30)});
+        coins.applyShielded(ChangeAction::Reset, {makeShielded(1, 100)});
+        QCOMPARE(coins.calculate(0, beam::Asset::s_BeamID, 0).maxAmount, Amount(180));
+
+        coins.applyNormal(ChangeAction::Removed, {makeCoin(2, 30)});
+        QCOMPARE(coins.calculate(0, beam::Asset::s_BeamID, 0).maxAmount, Amount(150));
+
+        // a coin which is not available anymore doesn't count
+        auto spent = makeCoin(1, 50);
+        spent.m_status = Coin::Outgoing;
+        coins.applyNormal(ChangeAction::Updated, {spent});
+        QCOMPARE(coins.calculate(0, beam::Asset::s_BeamID, 0).maxAmount, Amount(100));
+
+        // reset of normal coins leaves shielded ones alone
+        coins.applyNormal(ChangeAction::Reset, {makeCoin(3, 5)});
+        QCOMPARE(coins.calculate(0, beam::Asset::s_BeamID, 0).maxAmount, Amount(105));
+    }
+
+    void hugeAmountsSaturate()
+    {
+        const auto max = std::numeric_limits<Amount>::max();
+
+        CoinSelectionSnapshot coins;
+        coins.applyNormal(ChangeAction::Reset, {makeCoin(1, max), makeCoin(2, 1)});
+
+        const auto res = coins.calculate(max - 1, beam::Asset::s_BeamID, 10);
+        QVERIFY(res.isEnough);
+        QCOMPARE(res.changeBeam, Amount(0));
+        QCOMPARE(res.maxAmount, max - 10);
+    }
+
+    void nothingAvailable()
+    {
+        CoinSelectionSnapshot coins;
+
+        const auto res = coins.calculate(1, kAsset, 10);
+        QVERIFY(!res.isEnough);
+        QCOMPARE(res.maxAmount, Amount(0));
+    }
+};
+
+QTEST_APPLESS_MAIN(CoinSelectionSnapshotTest)
+
+#include "coin_selection_snapshot_test.moc"
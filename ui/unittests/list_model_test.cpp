@@ -0,0 +1,288 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <QtTest>
+#include <set>
+#include "viewmodel/helpers/list_model.h"
+
+namespace
+{
+    struct Row
+    {
+        int key;
+        int value;
+    };
+
+    bool byValue(const Row& left, const Row& right)
+    {
+        return left.value != right.value ? left.value < right.value : left.key < right.key;
+    }
+
+    class RowsModel : public KeyedListModel<Row, int>
+    {
+    public:
+        QVariant data(const QModelIndex& index, int role) const override
+        {
+            if (!index.isValid() || role != Qt::DisplayRole)
+            {
+                return QVariant();
+            }
+            return m_list[index.row()].value;
+        }
+
+        std::vector<int> keys() const
+        {
+            std::vector<int> res;
+            for (const auto& row : *this)
+            {
+                res.push_back(row.key);
+            }
+            return res;
+        }
+
+        bool isIndexConsistent() const
+        {
+            if (m_index.size() != size_t(m_list.size()))
+            {
+                return false;
+            }
+            for (int row = 0; row < m_list.size(); ++row)
+            {
+                if (indexOf(m_list[row].key) != row)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    protected:
+        int keyOf(const Row& row) const override
+        {
+            return row.key;
+        }
+    };
+
+    // records what the model told its views
+    struct Events
+    {
+        explicit Events(RowsModel& model)
+        {
+            QObject::connect(&model, &QAbstractItemModel::dataChanged, [this](const QModelIndex& first, const QModelIndex& last)
+            {
+                changed.emplace_back(first.row(), last.row());
+            });
+            QObject::connect(&model, &QAbstractItemModel::rowsInserted, [this](const QModelIndex&, int first, int last)
+            {
+                inserted.emplace_back(first, last);
+            });
+            QObject::connect(&model, &QAbstractItemModel::rowsRemoved, [this](const QModelIndex&, int first, int last)
+            {
+                removed.emplace_back(first, last);
+            });
+            QObject::connect(&model, &QAbstractItemModel::layoutChanged, [this]() { ++layouts; });
+            QObject::connect(&model, &QAbstractItemModel::modelReset, [this]() { ++resets; });
+        }
+
+        std::vector<std::pair<int, int>> changed;
+        std::vector<std::pair<int, int>> inserted;
+        std::vector<std::pair<int, int>> removed;
+        int layouts = 0;
+        int resets = 0;
+    };
+
+    std::vector<Row> makeRows(int from, int to)
+    {
+        std::vector<Row> rows;
+        for (int key = from; key < to; ++key)
+        {
+            rows.push_back({key, key * 10});
+        }
+        return rows;
+    }
+}
+
+class ListModelTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAppendsNewAndUpdatesKnownInPlace()
+    {
+        RowsModel model;
+        model.insert(makeRows(0, 3));
+
+        Events events(model);
+        model.insert(std::vector<Row>{{1, 111}, {5, 50}});
+
+        QCOMPARE(model.rowCount(), 4);
+        QCOMPARE(model.get(1).value, 111);
+        QCOMPARE(model.indexOf(5), 3);
+        QVERIFY(events.changed == (std::vector<std::pair<int, int>>{{1, 1}}));
+        QVERIFY(events.inserted == (std::vector<std::pair<int, int>>{{3, 3}}));
+        QVERIFY(model.isIndexConsistent());
+    }
+
+    void duplicatesInOneBatchCollapse()
+    {
+        RowsModel model;
+        model.insert(std::vector<Row>{{7, 1}, {8, 2}, {7, 3}});
+
+        QCOMPARE(model.rowCount(), 2);
+        QCOMPARE(model.get(model.indexOf(7)).value, 3);
+        QVERIFY(model.isIndexConsistent());
+    }
+
+    void removeKeysCoalescesRanges()
+    {
+        RowsModel model;
+        model.insert(makeRows(0, 10));
+
+        Events events(model);
+        model.removeKeys({2, 3, 4, 7, 42});
+
+        QVERIFY(model.keys() == (std::vector<int>{0, 1, 5, 6, 8, 9}));
+        QCOMPARE(int(events.removed.size()), 2);
+        QVERIFY(!model.contains(3));
+        QVERIFY(model.isIndexConsistent());
+    }
+
+    void retainKeepsOnlyGivenKeys()
+    {
+        RowsModel model;
+        model.insert(makeRows(0, 6));
+        model.retain(std::set<int>{1, 4, 9});
+
+        QVERIFY(model.keys() == (std::vector<int>{1, 4}));
+        QVERIFY(model.isIndexConsistent());
+    }
+
+    void resetRebuildsIndex()
+    {
+        RowsModel model;
+        model.insert(makeRows(0, 5));
+        model.reset(makeRows(3, 8));
+
+        QVERIFY(model.keys() == (std::vector<int>{3, 4, 5, 6, 7}));
+        QCOMPARE(model.indexOf(0), -1);
+        QVERIFY(model.isIndexConsistent());
+    }
+
+    void insertSortedPlacesAndMovesRows()
+    {
+        RowsModel model;
+        model.reset(std::vector<Row>{{1, 10}, {2, 20}, {3, 30}});
+
+        Events events(model);
+        // a new row in the middle, a fitting update and a move to the front
+        model.insertSorted(std::vector<Row>{{4, 25}, {2, 21}, {3, 5}}, byValue);
+
+        QVERIFY(model.keys() == (std::vector<int>{3, 1, 2, 4}));
+        QCOMPARE(model.get(model.indexOf(2)).value, 21);
+        QCOMPARE(events.resets, 0);
+        QVERIFY(model.isIndexConsistent());
+    }
+
+    void bigInsertSortedKeepsPersistentIndexes()
+    {
+        RowsModel model;
+        model.reset(std::vector<Row>{{1000, 500}, {1001, 1500}});
+        const QPersistentModelIndex tracked = model.index(1);
+
+        Events events(model);
+        std::vector<Row> items;
+        for (int key = 0; key < 100; ++key)
+        {
+            items.push_back({key, (99 - key) * 10});
+        }
+        model.insertSorted(items, byValue);
+
+        QCOMPARE(model.rowCount(), 102);
+        QCOMPARE(events.resets, 0);
+        QCOMPARE(events.layouts, 1);
+        QVERIFY(std::is_sorted(model.begin(), model.end(), byValue));
+        QVERIFY(tracked.isValid());
+        QCOMPARE(tracked.row(), model.indexOf(1001));
+        QVERIFY(model.isIndexConsistent());
+    }
+
+    void sortIsLayoutChange()
+    {
+        RowsModel model;
+        model.reset(std::vector<Row>{{1, 30}, {2, 10}, {3, 20}});
+        const QPersistentModelIndex tracked = model.index(0);
+
+        Events events(model);
+        model.sort(byValue);
+
+        QVERIFY(model.keys() == (std::vector<int>{2, 3, 1}));
+        QCOMPARE(events.layouts, 1);
+        QCOMPARE(events.resets, 0);
+        QCOMPARE(tracked.row(), 2);
+        QVERIFY(model.isIndexConsistent());
+
+        // already ordered, views are left alone
+        model.sort(byValue);
+        QCOMPARE(events.layouts, 1);
+    }
+
+    void touchRowsEmitsOnePerRange()
+    {
+        RowsModel model;
+        model.insert(makeRows(0, 8));
+
+        Events events(model);
+        model.touchRows({5, 1, 2, 3, 5, 7});
+
+        QVERIFY(events.changed == (std::vector<std::pair<int, int>>{{1, 3}, {5, 5}, {7, 7}}));
+    }
+
+    void keyGroupIndexMapsGroupsToKeys()
+    {
+        KeyGroupIndex<int, int> index;
+        const auto keysOf = [&index](const std::vector<int>& groups)
+        {
+            std::multiset<int> keys;
+            index.forEachKey(groups, [&keys](int key) { keys.insert(key); });
+            return keys;
+        };
+
+        index.add(1, std::vector<int>{10, 20});
+        index.add(2, std::vector<int>{20});
+        index.add(3, std::vector<int>{30, 30});
+        index.add(4, std::vector<int>{});
+
+        QVERIFY(keysOf({20}) == (std::multiset<int>{1, 2}));
+        QVERIFY(keysOf({10, 30}) == (std::multiset<int>{1, 3}));
+        QVERIFY(keysOf({40}).empty());
+
+        // adding a key again replaces its groups
+        index.add(1, std::vector<int>{30});
+        QVERIFY(keysOf({10}).empty());
+        QVERIFY(keysOf({20}) == (std::multiset<int>{2}));
+        QVERIFY(keysOf({30}) == (std::multiset<int>{1, 3}));
+
+        index.remove(3);
+        index.remove(4);
+        index.remove(42);
+        QVERIFY(keysOf({30}) == (std::multiset<int>{1}));
+
+        index.clear();
+        QVERIFY(keysOf({20, 30}).empty());
+    }
+};
+
+QTEST_APPLESS_MAIN(ListModelTest)
+
+#include "list_model_test.moc"
@@ -0,0 +1,139 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <QtTest>
+#include "viewmodel/helpers/order_book.h"
+
+namespace
+{
+    using Book = OrderBook<int>;
+
+    std::vector<int64_t> ticksOf(const std::vector<OrderBookLevel>& levels)
+    {
+        std::vector<int64_t> res;
+        for (const auto& level : levels)
+        {
+            res.push_back(level.ticks);
+        }
+        return res;
+    }
+}
+
+class OrderBookTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void bestPricesAndDepth()
+    {
+        Book book(2);
+        book.insert(1, true, 1.10, 10, 11);
+        book.insert(2, true, 1.30, 5, 6);
+        book.insert(3, true, 1.20, 7, 8);
+        book.insert(4, false, 1.50, 3, 4);
+        book.insert(5, false, 1.40, 2, 3);
+
+        QCOMPARE(*book.bestPrice(true), 1.30);
+        QCOMPARE(*book.bestPrice(false), 1.40);
+
+        // each side from its best price outwards
+        QVERIFY(ticksOf(book.depth(true)) == (std::vector<int64_t>{130, 120, 110}));
+        QVERIFY(ticksOf(book.depth(false)) == (std::vector<int64_t>{140, 150}));
+        QVERIFY(ticksOf(book.depth(true, 2)) == (std::vector<int64_t>{130, 120}));
+        QCOMPARE(int(book.size()), 5);
+    }
+
+    void pricesWithinStepShareLevel()
+    {
+        Book book(2);
+        book.insert(1, false, 0.101, 10, 1);
+        book.insert(2, false, 0.099, 20, 2);
+        book.insert(3, false, 0.106, 5, 1);
+
+        const auto asks = book.depth(false);
+        QCOMPARE(int(asks.size()), 2);
+        QCOMPARE(asks[0].ticks, int64_t(10));
+        QCOMPARE(asks[0].price, 0.10);
+        QCOMPARE(asks[0].size, uint64_t(30));
+        QCOMPARE(asks[0].total, uint64_t(3));
+        QCOMPARE(asks[0].count, 2);
+        QCOMPARE(asks[1].ticks, int64_t(11));
+    }
+
+    void insertSameKeyMovesOrder()
+    {
+        Book book(2);
+        book.insert(1, true, 1.00, 10, 10);
+        book.insert(2, true, 1.00, 5, 5);
+        book.insert(1, false, 2.00, 4, 8);
+
+        auto bids = book.depth(true);
+        QCOMPARE(int(bids.size()), 1);
+        QCOMPARE(bids[0].size, uint64_t(5));
+        QCOMPARE(bids[0].count, 1);
+        QCOMPARE(*book.bestPrice(false), 2.00);
+        QCOMPARE(int(book.size()), 2);
+    }
+
+    void removeDropsEmptyLevels()
+    {
+        Book book(2);
+        book.insert(1, true, 1.00, 10, 10);
+        book.insert(2, true, 1.00, 5, 5);
+
+        QVERIFY(book.remove(1));
+        QVERIFY(!book.remove(1));
+        QVERIFY(!book.contains(1));
+        QCOMPARE(book.depth(true)[0].size, uint64_t(5));
+
+        QVERIFY(book.remove(2));
+        QVERIFY(book.depth(true).empty());
+        QVERIFY(!book.bestPrice(true));
+        QVERIFY(!book.bestPrice(false));
+    }
+
+    void versionFollowsChanges()
+    {
+        Book book(2);
+        const auto initial = book.version();
+
+        book.insert(1, true, 1.00, 10, 10);
+        const auto inserted = book.version();
+        QVERIFY(inserted != initial);
+
+        book.remove(42);
+        QCOMPARE(book.version(), inserted);
+
+        book.clear();
+        QVERIFY(book.version() != inserted);
+        QCOMPARE(int(book.size()), 0);
+        QVERIFY(book.depth(true).empty());
+    }
+
+    void levelKeysDifferBySide()
+    {
+        OrderBookLevel bid;
+        bid.isBid = true;
+        bid.ticks = 100;
+
+        OrderBookLevel ask = bid;
+        ask.isBid = false;
+
+        QVERIFY(bid.key() != ask.key());
+    }
+};
+
+QTEST_APPLESS_MAIN(OrderBookTest)
+
+#include "order_book_test.moc"
@@ -0,0 +1,122 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <QtTest>
+#include "viewmodel/wallet/tx_search_index.h"
+
+namespace
+{
+    using TxID    = TxSearchIndex::TxID;
+    using Matches = TxSearchIndex::Matches;
+
+    TxID makeId(int n)
+    {
+        TxID id = {};
+        id[0] = static_cast<uint8_t>(n);
+        id[1] = static_cast<uint8_t>(n >> 8);
+        return id;
+    }
+
+    QString fold(const char* query)
+    {
+        return QString::fromUtf8(query).toCaseFolded();
+    }
+}
+
+class TxSearchIndexTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void findsCaseFoldedSubstrings()
+    {
+        TxSearchIndex index;
+        index.put(makeId(1), "Payment for Coffee");
+        index.put(makeId(2), "Rent");
+        index.put(makeId(3), "COFFEE beans");
+
+        QVERIFY(index.find(fold("coffee")) == (Matches{makeId(1), makeId(3)}));
+        QVERIFY(index.find(fold("FOR C")) == (Matches{makeId(1)}));
+        QVERIFY(index.find(fold("nothing")).empty());
+        QVERIFY(index.find(QString()).empty());
+
+        // every letter is there, just not in this order
+        QVERIFY(index.find(fold("eef")).empty());
+    }
+
+    void shortQueriesScanAllTexts()
+    {
+        TxSearchIndex index;
+        index.put(makeId(1), "abc");
+        index.put(makeId(2), "xyz");
+
+        QVERIFY(index.find(fold("B")) == (Matches{makeId(1)}));
+        QVERIFY(index.find(fold("yz")) == (Matches{makeId(2)}));
+    }
+
+    void putReplacesText()
+    {
+        TxSearchIndex index;
+        index.put(makeId(1), "alpha");
+        index.put(makeId(1), "beta");
+
+        QVERIFY(index.find(fold("alpha")).empty());
+        QVERIFY(index.find(fold("beta")) == (Matches{makeId(1)}));
+        QVERIFY(index.matches(makeId(1), fold("bet")));
+        QVERIFY(!index.matches(makeId(1), fold("alp")));
+    }
+
+    void removeAndClearForgetTexts()
+    {
+        TxSearchIndex index;
+        index.put(makeId(1), "alpha");
+        index.put(makeId(2), "alpine");
+        index.remove(makeId(1));
+        index.remove(makeId(42));
+
+        QVERIFY(index.find(fold("alp")) == (Matches{makeId(2)}));
+        QVERIFY(!index.matches(makeId(1), fold("alpha")));
+
+        index.clear();
+        QVERIFY(index.find(fold("alp")).empty());
+    }
+
+    void staleTextsAreSweptOut()
+    {
+        // enough updates to leave more stale entries than live ones
+        const int count = 3000;
+        TxSearchIndex index;
+        for (int i = 0; i < count; ++i)
+        {
+            index.put(makeId(i), QString("old %1 text").arg(i));
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            index.put(makeId(i), QString("new %1 text").arg(i));
+        }
+        for (int i = 0; i < count; i += 2)
+        {
+            index.remove(makeId(i));
+        }
+
+        QVERIFY(index.find(fold("old ")).empty());
+        QCOMPARE(int(index.find(fold("new ")).size()), count / 2);
+        QVERIFY(index.find(fold("new 1234 ")).empty());
+        QVERIFY(index.find(fold("new 1235 ")) == (Matches{makeId(1235)}));
+    }
+};
+
+QTEST_APPLESS_MAIN(TxSearchIndexTest)
+
+#include "tx_search_index_test.moc"
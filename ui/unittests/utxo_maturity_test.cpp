@@ -0,0 +1,65 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <QtTest>
+#include "viewmodel/utxo/utxo_maturity.h"
+
+using beam::Height;
+using namespace utxo_maturity;
+
+class UtxoMaturityTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void hoursAreWhole()
+    {
+        const Height maturity = 1000;
+
+        QCOMPARE(hoursLeft(maturity, 0), Height(16));
+        QCOMPARE(hoursLeft(maturity, 940), Height(1));
+        QCOMPARE(hoursLeft(maturity, 941), Height(0));
+        QCOMPARE(hoursLeft(maturity, 1000), Height(0));
+        QCOMPARE(hoursLeft(maturity, 5000), Height(0));
+    }
+
+    void nextUpdateIsWhereHoursDrop()
+    {
+        const Height maturity = 1000;
+
+        QCOMPARE(nextUpdate(maturity, 900), Height(941));
+        QCOMPARE(nextUpdate(maturity, 941), beam::MaxHeight);
+        QCOMPARE(nextUpdate(maturity, 1000), beam::MaxHeight);
+        QCOMPARE(nextUpdate(maturity, 5000), beam::MaxHeight);
+
+        // nothing changes between the current height and the update
+        for (Height current = 0; current <= maturity; ++current)
+        {
+            const auto next = nextUpdate(maturity, current);
+            if (next == beam::MaxHeight)
+            {
+                QCOMPARE(hoursLeft(maturity, current), Height(0));
+                continue;
+            }
+
+            QVERIFY(next > current);
+            QCOMPARE(hoursLeft(maturity, next - 1), hoursLeft(maturity, current));
+            QCOMPARE(hoursLeft(maturity, next), hoursLeft(maturity, current) - 1);
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(UtxoMaturityTest)
+
+#include "utxo_maturity_test.moc"
@@ -53,7 +53,7 @@ ColumnLayout {
         Layout.minimumHeight: 40
         Layout.maximumHeight: 40
         Layout.topMargin:       54
-        visible:                viewModel.contacts.length > 0  || viewModel.activeAddresses.length > 0 || viewModel.expiredAddresses.length > 0
+        visible:                viewModel.contacts.count > 0  || viewModel.activeAddresses.count > 0 || viewModel.expiredAddresses.count > 0
         TxFilter{
             id: activeAddressesFilter
             //% "My active addresses"
@@ -81,9 +81,9 @@ ColumnLayout {
         Layout.alignment: Qt.AlignHCenter
         Layout.fillHeight: true
         Layout.fillWidth:  true
-        visible:          contactsViewItem.visible && contactsView.model.length == 0 ||
-                          activeAddressesViewItem.visible && activeAddressesView.model.length == 0 ||
-                          expiredAddressesViewItem.visible && expiredAddressesView.model.length == 0
+        visible:          contactsViewItem.visible && contactsView.model.count == 0 ||
+                          activeAddressesViewItem.visible && activeAddressesView.model.count == 0 ||
+                          expiredAddressesViewItem.visible && expiredAddressesView.model.count == 0
     
         SvgImage {
             Layout.alignment: Qt.AlignHCenter
@@ -120,7 +120,7 @@ ColumnLayout {
                 id: activeAddressesView
                 model: viewModel.activeAddresses
                 parentModel: viewModel
-                visible: activeAddressesView.model.length > 0
+                visible: activeAddressesView.model.count > 0
 
                 sortIndicatorVisible: true
                 sortIndicatorColumn: 0
@@ -146,7 +146,7 @@ ColumnLayout {
             AddressTable {
                 id: expiredAddressesView
                 model: viewModel.expiredAddresses
-                visible: expiredAddressesView.model.length > 0
+                visible: expiredAddressesView.model.count > 0
                 parentModel: viewModel
                 isExpired: true
         
@@ -186,7 +186,7 @@ ColumnLayout {
                 sortIndicatorVisible: true
                 sortIndicatorColumn: 0
                 sortIndicatorOrder: Qt.DescendingOrder
-                visible:            contactsView.model.length > 0
+                visible:            contactsView.model.count > 0
                 
                 Binding{
                     target: viewModel
@@ -292,8 +292,8 @@ ColumnLayout {
                         onClicked: {
                             if (mouse.button == Qt.RightButton && styleData.row != undefined)
                             {
-                                contextMenu.walletID = contactsView.model[styleData.row].walletID;
-                                contextMenu.token = contactsView.model[styleData.row].token;
+                                contextMenu.walletID = contactsView.model.get(styleData.row).walletID;
+                                contextMenu.token = contactsView.model.get(styleData.row).token;
                                 contextMenu.popup();
                             }
                         }
@@ -322,8 +322,8 @@ ColumnLayout {
                                     //% "Actions"
                                     ToolTip.text: qsTrId("general-actions")
                                     onClicked: {
-                                        contextMenu.walletID = contactsView.model[styleData.row].walletID;
-                                        contextMenu.token = contactsView.model[styleData.row].token;
+                                        contextMenu.walletID = contactsView.model.get(styleData.row).walletID;
+                                        contextMenu.token = contactsView.model.get(styleData.row).token;
                                         contextMenu.popup();
                                     }
                                 }
@@ -190,7 +190,7 @@ CustomTableView {
             onClicked: {
                 if (mouse.button == Qt.RightButton && styleData.row != undefined)
                 {
-                    contextMenu.addressItem = rootControl.model[styleData.row]
+                    contextMenu.addressItem = rootControl.model.get(styleData.row)
                     contextMenu.popup()
                 }
             }
@@ -219,7 +219,7 @@ CustomTableView {
                         //% "Actions"
                         ToolTip.text: qsTrId("general-actions")
                         onClicked: {
-                            contextMenu.addressItem = rootControl.model[styleData.row]
+                            contextMenu.addressItem = rootControl.model.get(styleData.row)
                             contextMenu.popup()
                         }
                     }
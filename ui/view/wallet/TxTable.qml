@@ -16,6 +16,12 @@ Control {
         id: tableViewModel
     }
 
+    Binding {
+        target:   tableViewModel.transactions
+        property: "searchText"
+        value:    searchBox.text
+    }
+
     property int selectedAsset: -1
 
     state: "all"
@@ -77,6 +83,22 @@ Control {
        }
     }
 
+    ConfirmationDialog {
+        id: exportFailedDialog
+        //% "Ok"
+        okButtonText: qsTrId("general-ok")
+        okButtonIconSource: "qrc:/assets/icon-done.svg"
+        cancelButtonVisible: false
+    }
+
+    Connections {
+        target: tableViewModel
+        onExportFailed: function (message) {
+            exportFailedDialog.text = message;
+            exportFailedDialog.open();
+        }
+    }
+
     PaymentInfoDialog {
         id: paymentInfoDialog
         onTextCopied: function(text) {
@@ -149,14 +171,30 @@ Control {
                placeholderText: qsTrId("wallet-search-transactions-placeholder")
             }
 
+            CustomProgressBar {
+                Layout.alignment: Qt.AlignVCenter
+                backgroundImplicitWidth: 100
+                contentItemImplicitWidth: 100
+                visible: tableViewModel.exportInProgress
+                value: tableViewModel.exportProgress
+            }
+
             CustomToolButton {
                 Layout.alignment: Qt.AlignVCenter
-                icon.source: "qrc:/assets/icon-export.svg"
-                //: transactions history screen, export button tooltip and open file dialog
-                //% "Export transactions history"
-                ToolTip.text: qsTrId("wallet-export-tx-history")
+                icon.source: tableViewModel.exportInProgress ? "qrc:/assets/icon-cancel.svg" : "qrc:/assets/icon-export.svg"
+                ToolTip.text: tableViewModel.exportInProgress ?
+                    //: transactions history screen, cancel export button tooltip
+                    //% "Cancel export"
+                    qsTrId("wallet-cancel-export-tx-history") :
+                    //: transactions history screen, export button tooltip and open file dialog
+                    //% "Export transactions history"
+                    qsTrId("wallet-export-tx-history")
                 onClicked: {
-                    tableViewModel.exportTxHistoryToCsv();
+                    if (tableViewModel.exportInProgress) {
+                        tableViewModel.cancelExport();
+                    } else {
+                        tableViewModel.exportTxHistoryToCsv();
+                    }
                 }
             }
 
@@ -203,8 +241,25 @@ Control {
 
         CustomTableView {
             id: transactionsTable
-            Component.onCompleted: {
-                transactionsTable.model.modelReset.connect(function(){
+
+            // history is loaded by pages newest first, other orders need all of it
+            readonly property bool pagedOrder: sortIndicatorColumn == 4 && sortIndicatorOrder == Qt.DescendingOrder
+            onPagedOrderChanged: {
+                if (!pagedOrder) tableViewModel.loadAllTransactions();
+            }
+
+            Connections {
+                target: transactionsTable.flickableItem
+                onAtYBeginningChanged: {
+                    if (transactionsTable.flickableItem.atYBeginning && transactionsTable.pagedOrder && !searchBox.text.length) {
+                        tableViewModel.evictTransactions();
+                    }
+                }
+            }
+
+            Connections {
+                target: tableViewModel
+                onTransactionsLoaded: {
                     if (root.openedTxID != "") {
                         var index = tableViewModel.transactions.index(0, 0);
                         var indexList = tableViewModel.transactions.match(index, TxObjectList.Roles.TxID, root.openedTxID)
@@ -215,7 +270,13 @@ Control {
                             transactionsTable.positionViewAtRow(index.row, ListView.Beginning)
                         }
                     }
-                })
+                }
+            }
+
+            Component.onCompleted: {
+                if (root.openedTxID != "") {
+                    tableViewModel.loadAllTransactions();
+                }
             }
 
             Layout.alignment:     Qt.AlignTop
@@ -243,16 +304,11 @@ Control {
 
                 source: SortFilterProxyModel {
                     id: searchProxyModel
-                    filterRole: "search"
-                    filterString: searchBox.text
-                    filterSyntax: SortFilterProxyModel.Wildcard
-                    filterCaseSensitivity: Qt.CaseInsensitive
+                    filters: [{role: "searchMatch", type: "equals", value: true}]
 
                     source: SortFilterProxyModel {
                         id:           assetFilterProxy
-                        filterRole:   "assetFilter"
-                        filterString: control.selectedAsset < 0 ? "" : ["\\b", control.selectedAsset, "\\b"].join("")
-                        filterSyntax: SortFilterProxyModel.RegExp
+                        filters:      control.selectedAsset < 0 ? [] : [{role: "assetFilter", type: "anyOf", values: [control.selectedAsset]}]
                         source:       tableViewModel.transactions
                     }
                 }
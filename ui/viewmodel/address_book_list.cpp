@@ -0,0 +1,563 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "address_book_list.h"
+#include <QRunnable>
+#include "ui_helpers.h"
+#include "model/app_model.h"
+
+using namespace beam;
+
+namespace
+{
+    // lists of this size and bigger are sorted off the UI thread
+    const int kAsyncSortThreshold = 2000;
+
+    // generations are unique across all lists, an item moved to another
+    // list never takes its key for one built by the new list
+    uint32_t nextKeyGeneration()
+    {
+        static uint32_t generation = 0;
+        return ++generation;
+    }
+
+    using Roles = AddressBookList::Roles;
+
+    template<typename T>
+    int compare(const T& lf, const T& rt)
+    {
+        if (lf < rt)
+            return -1;
+        if (rt < lf)
+            return 1;
+        return 0;
+    }
+
+    // human readable columns are compared by collation keys, the rest as is
+    bool isCollated(Roles role)
+    {
+        return role == Roles::Name || role == Roles::Category;
+    }
+
+    const QString& sortText(Roles role, const AddressItem& item)
+    {
+        return role == Roles::Category ? item.getCategory() : item.getName();
+    }
+
+    int compareValues(Roles role, const AddressItem& left, const AddressItem& right)
+    {
+        switch (role)
+        {
+            case Roles::Name:
+                return compare(left.getName(), right.getName());
+            case Roles::Token:
+                return compare(left.getToken(), right.getToken());
+            case Roles::WalletID:
+                return compare(left.getWalletID(), right.getWalletID());
+            case Roles::Category:
+                return compare(left.getCategory(), right.getCategory());
+            case Roles::Identity:
+                return compare(left.getIdentity(), right.getIdentity());
+            case Roles::ExpirationDate:
+                return compare(left.getExpirationTimestamp(), right.getExpirationTimestamp());
+            default:
+                return compare(left.getCreateTimestamp(), right.getCreateTimestamp());
+        }
+    }
+
+    // equal keys keep a stable order, binary insertion relies on it
+    bool isOrdered(int res, Qt::SortOrder order, const AddressItem& left, const AddressItem& right)
+    {
+        if (order == Qt::DescendingOrder)
+        {
+            res = -res;
+        }
+        return res != 0 ? res < 0 : left.getAddress().m_walletID < right.getAddress().m_walletID;
+    }
+
+    QLocale getAppLocale()
+    {
+        return QLocale(AppModel::getInstance().getSettings().getLocale());
+    }
+}
+
+AddressItem::AddressItem(beam::wallet::WalletAddress address)
+    : m_walletAddress(std::move(address))
+    , m_walletID(QString::fromStdString(std::to_string(m_walletAddress.m_walletID)))
+    , m_token(QString::fromStdString(m_walletAddress.m_Address))
+    , m_name(QString::fromStdString(m_walletAddress.m_label))
+    , m_category(QString::fromStdString(m_walletAddress.m_category))
+{
+    // contacts may come without identity
+    if (m_walletAddress.m_Identity != Zero)
+    {
+        m_identity = beamui::toString(m_walletAddress.m_Identity);
+    }
+}
+
+const QString& AddressItem::getToken() const
+{
+    return m_token;
+}
+
+const QString& AddressItem::getWalletID() const
+{
+    return m_walletID;
+}
+
+const QString& AddressItem::getName() const
+{
+    return m_name;
+}
+
+const QString& AddressItem::getCategory() const
+{
+    return m_category;
+}
+
+const QString& AddressItem::getIdentity() const
+{
+    return m_identity;
+}
+
+QDateTime AddressItem::getExpirationDate() const
+{
+    QDateTime datetime;
+    datetime.setTime_t(m_walletAddress.getExpirationTime());
+    
+    return datetime;
+}
+
+QDateTime AddressItem::getCreateDate() const
+{
+    QDateTime datetime;
+    datetime.setTime_t(m_walletAddress.getCreateTime());
+    
+    return datetime;
+}
+
+bool AddressItem::isNeverExpired() const
+{
+    return (m_walletAddress.m_duration == 0);
+}
+
+bool AddressItem::isExpired() const
+{
+    return m_walletAddress.isExpired();
+}
+
+beam::Timestamp AddressItem::getCreateTimestamp() const
+{
+    return m_walletAddress.getCreateTime();
+}
+
+beam::Timestamp AddressItem::getExpirationTimestamp() const
+{
+    return m_walletAddress.getExpirationTime();
+}
+
+const beam::wallet::WalletAddress& AddressItem::getAddress() const
+{
+    return m_walletAddress;
+}
+
+const QCollatorSortKey& AddressItem::getSortKey(const QString& text, const QCollator& collator, uint32_t generation) const
+{
+    if (!m_sortKey || m_sortKeyGeneration != generation)
+    {
+        m_sortKey = collator.sortKey(text);
+        m_sortKeyGeneration = generation;
+    }
+    return *m_sortKey;
+}
+
+class AddressBookList::SortJob : public QRunnable
+{
+public:
+    SortJob(AddressBookList* owner, uint64_t jobId, std::vector<ItemPtr> items,
+            Roles role, Qt::SortOrder order, const QCollator& collator)
+        : _owner(owner)
+        , _jobId(jobId)
+        , _items(std::move(items))
+        , _role(role)
+        , _order(order)
+        , _collator(collator)
+    {
+    }
+
+    void run() override
+    {
+        // keys are local to the job, items' own key caches belong to the UI thread
+        std::vector<std::pair<std::optional<QCollatorSortKey>, ItemPtr>> entries;
+        entries.reserve(_items.size());
+        const bool collated = isCollated(_role);
+        for (auto& item : _items)
+        {
+            std::optional<QCollatorSortKey> key;
+            if (collated)
+            {
+                key = _collator.sortKey(sortText(_role, *item));
+            }
+            entries.emplace_back(std::move(key), std::move(item));
+        }
+
+        std::sort(entries.begin(), entries.end(), [this, collated](const auto& left, const auto& right)
+        {
+            const int res = collated
+                ? left.first->compare(*right.first)
+                : compareValues(_role, *left.second, *right.second);
+            return isOrdered(res, _order, *left.second, *right.second);
+        });
+
+        std::vector<ItemPtr> sorted;
+        sorted.reserve(entries.size());
+        for (auto& entry : entries)
+        {
+            sorted.push_back(std::move(entry.second));
+        }
+
+        // the owner waits for the pool in its destructor
+        auto owner = _owner;
+        QMetaObject::invokeMethod(owner, [owner, jobId = _jobId, sorted = std::move(sorted)]()
+        {
+            owner->onSorted(jobId, sorted);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    AddressBookList* _owner;
+    uint64_t _jobId;
+    std::vector<ItemPtr> _items;
+    Roles _role;
+    Qt::SortOrder _order;
+    QCollator _collator;
+};
+
+AddressBookList::AddressBookList(Roles defaultSortRole)
+    : m_defaultSortRole(defaultSortRole)
+    , m_sortRole(defaultSortRole)
+    , m_collator(getAppLocale())
+    , m_keyGeneration(nextKeyGeneration())
+{
+    m_pool.setMaxThreadCount(1);
+
+    connect(this, &QAbstractItemModel::rowsInserted, this, &AddressBookList::countChanged);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &AddressBookList::countChanged);
+    connect(this, &QAbstractItemModel::modelReset, this, &AddressBookList::countChanged);
+    connect(&AppModel::getInstance().getSettings(), &WalletSettings::localeChanged, this, &AddressBookList::onLocaleChanged);
+}
+
+AddressBookList::~AddressBookList()
+{
+    m_pool.waitForDone();
+}
+
+QHash<int, QByteArray> AddressBookList::roleNames() const
+{
+    static const auto roles = QHash<int, QByteArray>
+    {
+        { static_cast<int>(Roles::Name), "name" },
+        { static_cast<int>(Roles::Token), "token" },
+        { static_cast<int>(Roles::WalletID), "walletID" },
+        { static_cast<int>(Roles::Category), "category" },
+        { static_cast<int>(Roles::Identity), "identity" },
+        { static_cast<int>(Roles::ExpirationDate), "expirationDate" },
+        { static_cast<int>(Roles::CreateDate), "createDate" },
+        { static_cast<int>(Roles::NeverExpired), "neverExpired" },
+        { static_cast<int>(Roles::IsExpired), "isExpired" }
+    };
+    return roles;
+}
+
+QVariant AddressBookList::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_list.size())
+    {
+       return QVariant();
+    }
+
+    const auto& value = m_list[index.row()];
+    switch (static_cast<Roles>(role))
+    {
+        case Roles::Name:
+            return value->getName();
+        case Roles::Token:
+            return value->getToken();
+        case Roles::WalletID:
+            return value->getWalletID();
+        case Roles::Category:
+            return value->getCategory();
+        case Roles::Identity:
+            return value->getIdentity();
+        case Roles::ExpirationDate:
+            return value->getExpirationDate();
+        case Roles::CreateDate:
+            return value->getCreateDate();
+        case Roles::NeverExpired:
+            return value->isNeverExpired();
+        case Roles::IsExpired:
+            return value->isExpired();
+        default:
+            return QVariant();
+    }
+}
+
+int AddressBookList::count() const
+{
+    return m_list.size();
+}
+
+QVariantMap AddressBookList::get(int row) const
+{
+    QVariantMap result;
+    if (row < 0 || row >= m_list.size())
+    {
+        return result;
+    }
+
+    const auto& names = roleNames();
+    for (auto it = names.begin(); it != names.end(); ++it)
+    {
+        result.insert(QString::fromLatin1(it.value()), data(index(row), it.key()));
+    }
+    return result;
+}
+
+void AddressBookList::setSort(const QString& role, Qt::SortOrder order)
+{
+    auto sortRole = m_defaultSortRole;
+    const auto& names = roleNames();
+    for (auto it = names.begin(); it != names.end(); ++it)
+    {
+        if (role == QString::fromLatin1(it.value()))
+        {
+            sortRole = static_cast<Roles>(it.key());
+            break;
+        }
+    }
+
+    if (sortRole == m_sortRole && order == m_sortOrder)
+    {
+        return;
+    }
+
+    if (sortRole != m_sortRole)
+    {
+        m_keyGeneration = nextKeyGeneration();
+    }
+    m_sortRole = sortRole;
+    m_sortOrder = order;
+    resort();
+}
+
+void AddressBookList::resetSorted(std::vector<ItemPtr> items)
+{
+    m_pending.clear();
+    if (int(items.size()) < kAsyncSortThreshold)
+    {
+        m_sorting = false;
+        ++m_sortJobId; // results of a running job are dropped
+        std::sort(items.begin(), items.end(), [this](const ItemPtr& left, const ItemPtr& right) { return lessThan(left, right); });
+        reset(items);
+        return;
+    }
+
+    // rows already shown are updated in place, new ones appear when the order is known
+    std::unordered_set<beam::wallet::WalletID, WalletIDHash> keys;
+    std::vector<ItemPtr> shown;
+    keys.reserve(items.size());
+    for (const auto& item : items)
+    {
+        const auto key = keyOf(item);
+        keys.insert(key);
+        if (contains(key))
+        {
+            shown.push_back(item);
+        }
+        else
+        {
+            m_pending[key] = item;
+        }
+    }
+
+    retain(keys);
+    insert(shown);
+    startSortJob(std::move(items));
+}
+
+void AddressBookList::insertSorted(const std::vector<ItemPtr>& items)
+{
+    if (m_sorting)
+    {
+        // the job result is merged with these rows when it comes
+        std::vector<ItemPtr> shown;
+        for (const auto& item : items)
+        {
+            auto it = m_pending.find(keyOf(item));
+            if (it != m_pending.end())
+            {
+                it->second = item;
+            }
+            else
+            {
+                shown.push_back(item);
+            }
+        }
+        insert(shown);
+        return;
+    }
+    KeyedListModel::insertSorted(items, [this](const ItemPtr& left, const ItemPtr& right) { return lessThan(left, right); });
+}
+
+void AddressBookList::removeKeys(const std::vector<beam::wallet::WalletID>& keys)
+{
+    for (const auto& key : keys)
+    {
+        m_pending.erase(key);
+    }
+    KeyedListModel::removeKeys(keys);
+}
+
+AddressBookList::ItemPtr AddressBookList::find(const beam::wallet::WalletID& id) const
+{
+    const auto row = indexOf(id);
+    if (row >= 0)
+    {
+        return m_list[row];
+    }
+
+    const auto it = m_pending.find(id);
+    return it != m_pending.end() ? it->second : ItemPtr();
+}
+
+beam::wallet::WalletID AddressBookList::keyOf(const ItemPtr& item) const
+{
+    return item->getAddress().m_walletID;
+}
+
+bool AddressBookList::lessThan(const ItemPtr& left, const ItemPtr& right) const
+{
+    int res = 0;
+    if (isCollated(m_sortRole))
+    {
+        const auto& leftKey = left->getSortKey(sortText(m_sortRole, *left), m_collator, m_keyGeneration);
+        const auto& rightKey = right->getSortKey(sortText(m_sortRole, *right), m_collator, m_keyGeneration);
+        res = leftKey.compare(rightKey);
+    }
+    else
+    {
+        res = compareValues(m_sortRole, *left, *right);
+    }
+    return isOrdered(res, m_sortOrder, *left, *right);
+}
+
+void AddressBookList::resort()
+{
+    if (m_list.size() + int(m_pending.size()) >= kAsyncSortThreshold)
+    {
+        std::vector<ItemPtr> items(m_list.begin(), m_list.end());
+        for (const auto& pending : m_pending)
+        {
+            items.push_back(pending.second);
+        }
+        startSortJob(std::move(items));
+        return;
+    }
+
+    m_sorting = false;
+    ++m_sortJobId; // results of a running job are dropped
+    showPending();
+    sort([this](const ItemPtr& left, const ItemPtr& right) { return lessThan(left, right); });
+}
+
+void AddressBookList::startSortJob(std::vector<ItemPtr> items)
+{
+    m_sorting = true;
+    m_pool.start(new SortJob(this, ++m_sortJobId, std::move(items), m_sortRole, m_sortOrder, m_collator));
+}
+
+void AddressBookList::onSorted(uint64_t jobId, const std::vector<ItemPtr>& items)
+{
+    if (jobId != m_sortJobId)
+    {
+        return;
+    }
+
+    m_sorting = false;
+
+    // rows waiting for the order are added at the tail and moved with the rest
+    showPending();
+
+    // rows which are the same as in the job take its order, rows added or
+    // changed meanwhile are merged in with binary search, so churn never restarts the job
+    std::vector<int> order;
+    std::vector<bool> placed(m_list.size(), false);
+    order.reserve(m_list.size());
+    for (const auto& item : items)
+    {
+        const int row = indexOf(keyOf(item));
+        if (row >= 0 && m_list[row] == item)
+        {
+            order.push_back(row);
+            placed[row] = true;
+        }
+    }
+
+    const auto less = [this](int left, int right) { return lessThan(m_list[left], m_list[right]); };
+    std::vector<int> late;
+    for (int row = 0; row < m_list.size(); ++row)
+    {
+        if (!placed[row])
+        {
+            late.push_back(row);
+        }
+    }
+    std::sort(late.begin(), late.end(), less);
+
+    std::vector<int> merged;
+    merged.reserve(m_list.size());
+    auto pos = order.begin();
+    for (int row : late)
+    {
+        auto next = std::upper_bound(pos, order.end(), row, less);
+        merged.insert(merged.end(), pos, next);
+        merged.push_back(row);
+        pos = next;
+    }
+    merged.insert(merged.end(), pos, order.end());
+
+    applyOrder(merged);
+}
+
+void AddressBookList::showPending()
+{
+    std::vector<ItemPtr> pending;
+    pending.reserve(m_pending.size());
+    for (const auto& item : m_pending)
+    {
+        pending.push_back(item.second);
+    }
+    m_pending.clear();
+    insert(pending);
+}
+
+void AddressBookList::onLocaleChanged()
+{
+    m_collator.setLocale(getAppLocale());
+    m_keyGeneration = nextKeyGeneration();
+    if (isCollated(m_sortRole))
+    {
+        resort();
+    }
+}
@@ -0,0 +1,139 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QCollator>
+#include <QDateTime>
+#include <QThreadPool>
+#include <QVariantMap>
+#include <optional>
+#include <unordered_map>
+#include "model/wallet_model.h"
+#include "viewmodel/helpers/list_model.h"
+
+// Text fields are converted once, rows are sorted and painted from them
+class AddressItem
+{
+public:
+    AddressItem() = default;
+    explicit AddressItem(beam::wallet::WalletAddress);
+
+    const QString& getWalletID() const;
+    const QString& getToken() const;
+    const QString& getName() const;
+    const QString& getCategory() const;
+    const QString& getIdentity() const;
+    QDateTime getExpirationDate() const;
+    QDateTime getCreateDate() const;
+    bool isNeverExpired() const;
+
+    bool isExpired() const;
+    beam::Timestamp getCreateTimestamp() const;
+    beam::Timestamp getExpirationTimestamp() const;
+
+    const beam::wallet::WalletAddress& getAddress() const;
+
+    // collation key of the text, built once per key generation of the owning list.
+    // Generations are never shared by lists, so a moved item rebuilds its key
+    const QCollatorSortKey& getSortKey(const QString& text, const QCollator& collator, uint32_t generation) const;
+
+private:
+    beam::wallet::WalletAddress m_walletAddress;
+    QString m_walletID;
+    QString m_token;
+    QString m_name;
+    QString m_category;
+    QString m_identity;
+
+    mutable std::optional<QCollatorSortKey> m_sortKey;
+    mutable uint32_t m_sortKeyGeneration = 0;
+};
+
+struct WalletIDHash
+{
+    size_t operator()(const beam::wallet::WalletID& id) const
+    {
+        return qHashBits(&id, sizeof(id));
+    }
+};
+
+// Address book rows keyed by WalletID, kept in the current sort order
+class AddressBookList : public KeyedListModel<std::shared_ptr<AddressItem>, beam::wallet::WalletID, WalletIDHash>
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum class Roles
+    {
+        Name = Qt::UserRole + 1,
+        Token,
+        WalletID,
+        Category,
+        Identity,
+        ExpirationDate,
+        CreateDate,
+        NeverExpired,
+        IsExpired
+    };
+
+    using ItemPtr = std::shared_ptr<AddressItem>;
+
+    explicit AddressBookList(Roles defaultSortRole);
+    ~AddressBookList() override;
+
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const;
+    Q_INVOKABLE QVariantMap get(int row) const;
+
+    void setSort(const QString& role, Qt::SortOrder order);
+    void resetSorted(std::vector<ItemPtr> items);
+    void insertSorted(const std::vector<ItemPtr>& items);
+    void removeKeys(const std::vector<beam::wallet::WalletID>& keys) override;
+    // finds shown rows and rows waiting for a running sort
+    ItemPtr find(const beam::wallet::WalletID& id) const;
+
+signals:
+    void countChanged();
+
+private:
+    class SortJob;
+
+    beam::wallet::WalletID keyOf(const ItemPtr& item) const override;
+
+    bool lessThan(const ItemPtr& left, const ItemPtr& right) const;
+    void resort();
+    void startSortJob(std::vector<ItemPtr> items);
+    void onSorted(uint64_t jobId, const std::vector<ItemPtr>& items);
+    void showPending();
+    void onLocaleChanged();
+
+    Roles m_defaultSortRole;
+    Roles m_sortRole;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+
+    // keys are rebuilt when the sort column or the locale changes
+    QCollator m_collator;
+    uint32_t m_keyGeneration;
+
+    // big lists are sorted on the pool, rows changed meanwhile are merged
+    // into the result. New rows of a big reset wait for the order in m_pending
+    QThreadPool m_pool;
+    uint64_t m_sortJobId = 0;
+    bool m_sorting = false;
+    std::unordered_map<beam::wallet::WalletID, ItemPtr, WalletIDHash> m_pending;
+};
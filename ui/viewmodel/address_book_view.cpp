@@ -23,157 +23,49 @@ using namespace std;
 using namespace beam;
 using namespace beamui;
 
-namespace
-{
-    template<typename T>
-    bool compare(const T& lf, const T& rt, Qt::SortOrder sortOrder)
-    {
-        if (sortOrder == Qt::DescendingOrder)
-            return lf > rt;
-        return lf < rt;
-    }
-}
-
-AddressItem::AddressItem(beam::wallet::WalletAddress address)
-    : m_walletAddress(std::move(address))
-{
-
-}
-
-QString AddressItem::getToken() const
-{
-    return QString::fromStdString(m_walletAddress.m_Address);
-}
-
-QString AddressItem::getWalletID() const
-{
-    return QString::fromStdString(std::to_string(m_walletAddress.m_walletID));
-}
-
-QString AddressItem::getName() const
-{
-    return QString::fromStdString(m_walletAddress.m_label);
-}
-
-QString AddressItem::getCategory() const
-{
-    return QString::fromStdString(m_walletAddress.m_category);
-}
-
-QString AddressItem::getIdentity() const
-{
-    return beamui::toString(m_walletAddress.m_Identity);
-}
-
-QDateTime AddressItem::getExpirationDate() const
-{
-    QDateTime datetime;
-    datetime.setTime_t(m_walletAddress.getExpirationTime());
-    
-    return datetime;
-}
-
-QDateTime AddressItem::getCreateDate() const
-{
-    QDateTime datetime;
-    datetime.setTime_t(m_walletAddress.getCreateTime());
-    
-    return datetime;
-}
-
-bool AddressItem::isNeverExpired() const
-{
-    return (m_walletAddress.m_duration == 0);
-}
-
-bool AddressItem::isExpired() const
-{
-    return m_walletAddress.isExpired();
-}
-
-beam::Timestamp AddressItem::getCreateTimestamp() const
-{
-    return m_walletAddress.getCreateTime();
-}
-
-beam::Timestamp AddressItem::getExpirationTimestamp() const
-{
-    return m_walletAddress.getExpirationTime();
-}
-
-ContactItem::ContactItem(const beam::wallet::WalletAddress& address)
-    : m_walletAddress(address)
-{
-
-}
-
-QString ContactItem::getWalletID() const
-{
-    return QString::fromStdString(std::to_string(m_walletAddress.m_walletID));
-}
-
-QString ContactItem::getName() const
-{
-    return QString::fromStdString(m_walletAddress.m_label);
-}
-
-QString ContactItem::getCategory() const
-{
-    return QString::fromStdString(m_walletAddress.m_category);
-}
-
-QString ContactItem::getIdentity() const
-{
-    if (m_walletAddress.m_Identity != Zero)
-    {
-        return beamui::toString(m_walletAddress.m_Identity);
-    }
-    return QString();
-}
-
-QString ContactItem::getToken() const
-{
-    return QString::fromStdString(m_walletAddress.m_Address);
-}
-
 AddressBookViewModel::AddressBookViewModel()
     : m_model{*AppModel::getInstance().getWalletModel()}
+    , m_contacts(AddressBookList::Roles::Name)
+    , m_activeAddresses(AddressBookList::Roles::CreateDate)
+    , m_expiredAddresses(AddressBookList::Roles::CreateDate)
 {
     connect(&m_model,
             SIGNAL(addressesChanged(bool, const std::vector<beam::wallet::WalletAddress>&)),
             SLOT(onAddresses(bool, const std::vector<beam::wallet::WalletAddress>&)));
-    connect(&m_model,
-            SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)),
-            SLOT(onTransactions(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)));
     connect(&m_model,
             SIGNAL(addressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>&)),
             SLOT(onAddressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>&)));
 
+    auto store = AppModel::getInstance().getTransactions();
+    connect(store.get(), &TransactionsStore::transactionsChanged, this, &AddressBookViewModel::onTransactions);
+
     getAddressesFromModel();
-    m_model.getAsync()->getTransactions();
-    startTimer(3 * 1000);
-}
 
-AddressBookViewModel::~AddressBookViewModel()
-{
-    qDeleteAll(m_contacts);
-    qDeleteAll(m_activeAddresses);
-    qDeleteAll(m_expiredAddresses);
+    if (store->isLoaded())
+    {
+        onTransactions(beam::wallet::ChangeAction::Reset, store->getAll());
+    }
+    else
+    {
+        store->load();
+    }
+    m_expiryTimer.setSingleShot(true);
+    connect(&m_expiryTimer, &QTimer::timeout, this, &AddressBookViewModel::onExpiryTimer);
 }
 
-QQmlListProperty<ContactItem> AddressBookViewModel::getContacts()
+QAbstractItemModel* AddressBookViewModel::getContacts()
 {
-    return CreateQmlListProperty<ContactItem>(this, m_contacts);
+    return &m_contacts;
 }
 
-QQmlListProperty<AddressItem> AddressBookViewModel::getActiveAddresses()
+QAbstractItemModel* AddressBookViewModel::getActiveAddresses()
 {
-    return CreateQmlListProperty<AddressItem>(this, m_activeAddresses);
+    return &m_activeAddresses;
 }
 
-QQmlListProperty<AddressItem> AddressBookViewModel::getExpiredAddresses()
+QAbstractItemModel* AddressBookViewModel::getExpiredAddresses()
 {
-    return CreateQmlListProperty<AddressItem>(this, m_expiredAddresses);
+    return &m_expiredAddresses;
 }
 
 QString AddressBookViewModel::nameRole() const
@@ -231,7 +123,7 @@ void AddressBookViewModel::setActiveAddrSortOrder(Qt::SortOrder value)
     if (m_activeAddrSortOrder != value)
     {
         m_activeAddrSortOrder = value;
-        sortActiveAddresses();
+        m_activeAddresses.setSort(m_activeAddrSortRole, m_activeAddrSortOrder);
     }
 }
 
@@ -240,7 +132,7 @@ void AddressBookViewModel::setExpiredAddrSortOrder(Qt::SortOrder value)
     if (m_expiredAddrSortOrder != value)
     {
         m_expiredAddrSortOrder = value;
-        sortExpiredAddresses();
+        m_expiredAddresses.setSort(m_expiredAddrSortRole, m_expiredAddrSortOrder);
     }
 }
 
@@ -249,7 +141,7 @@ void AddressBookViewModel::setContactSortOrder(Qt::SortOrder value)
     if (m_contactSortOrder != value)
     {
         m_contactSortOrder = value;
-        sortContacts();
+        m_contacts.setSort(m_contactSortRole, m_contactSortOrder);
     }
 }
 
@@ -273,7 +165,7 @@ void AddressBookViewModel::setActiveAddrSortRole(QString value)
     if (m_activeAddrSortRole != value)
     {
         m_activeAddrSortRole = value;
-        sortActiveAddresses();
+        m_activeAddresses.setSort(m_activeAddrSortRole, m_activeAddrSortOrder);
     }
 }
 
@@ -282,7 +174,7 @@ void AddressBookViewModel::setExpiredAddrSortRole(QString value)
     if (m_expiredAddrSortRole != value)
     {
         m_expiredAddrSortRole = value;
-        sortExpiredAddresses();
+        m_expiredAddresses.setSort(m_expiredAddrSortRole, m_expiredAddrSortOrder);
     }
 }
 
@@ -291,7 +183,7 @@ void AddressBookViewModel::setContactSortRole(QString value)
     if (m_contactSortRole != value)
     {
         m_contactSortRole = value;
-        sortContacts();
+        m_contacts.setSort(m_contactSortRole, m_contactSortOrder);
     }
 }
 
@@ -333,42 +225,88 @@ void AddressBookViewModel::onAddresses(bool own, const std::vector<beam::wallet:
 {
     if (own)
     {
-        qDeleteAll(m_activeAddresses); m_activeAddresses.clear();
-        qDeleteAll(m_expiredAddresses); m_expiredAddresses.clear();
-
+        std::vector<AddressBookList::ItemPtr> active, expired;
         for (const auto& addr : addresses)
         {
             assert(!addr.m_Address.empty());
-            if (addr.isExpired())
-            {
-                m_expiredAddresses.push_back(new AddressItem(addr));
-            }
-            else
-            {
-                m_activeAddresses.push_back(new AddressItem(addr));
-            }
+            auto item = std::make_shared<AddressItem>(addr);
+            (addr.isExpired() ? expired : active).push_back(std::move(item));
         }
 
-        sortActiveAddresses();
-        sortExpiredAddresses();
+        m_expiries = decltype(m_expiries)();
+        scheduleExpiry(active);
+
+        m_activeAddresses.resetSorted(std::move(active));
+        m_expiredAddresses.resetSorted(std::move(expired));
     }
     else
     {
-        qDeleteAll(m_contacts); m_contacts.clear();
-
+        std::vector<AddressBookList::ItemPtr> contacts;
+        contacts.reserve(addresses.size());
         for (const auto& addr : addresses)
         {
-            m_contacts.push_back(new ContactItem(addr));
+            contacts.push_back(std::make_shared<AddressItem>(addr));
         }
 
-        sortContacts();
+        m_contacts.resetSorted(std::move(contacts));
     }
 }
 
-void AddressBookViewModel::onAddressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>& addresses)
+void AddressBookViewModel::onAddressesChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::WalletAddress>& addresses)
 {
-    // TODO: refactor this
-    getAddressesFromModel();
+    using namespace beam::wallet;
+
+    if (action == ChangeAction::Reset)
+    {
+        getAddressesFromModel();
+        return;
+    }
+
+    // an address moves between the lists when it expires or gets extended,
+    // so it is removed from the lists it doesn't belong to anymore
+    std::vector<WalletID> notActive, notExpired, notContacts;
+    std::vector<AddressBookList::ItemPtr> active, expired, contacts;
+
+    for (const auto& addr : addresses)
+    {
+        if (action == ChangeAction::Removed)
+        {
+            notActive.push_back(addr.m_walletID);
+            notExpired.push_back(addr.m_walletID);
+            notContacts.push_back(addr.m_walletID);
+            continue;
+        }
+
+        auto item = std::make_shared<AddressItem>(addr);
+        if (!addr.isOwn())
+        {
+            contacts.push_back(std::move(item));
+            notActive.push_back(addr.m_walletID);
+            notExpired.push_back(addr.m_walletID);
+        }
+        else if (addr.isExpired())
+        {
+            expired.push_back(std::move(item));
+            notActive.push_back(addr.m_walletID);
+            notContacts.push_back(addr.m_walletID);
+        }
+        else
+        {
+            active.push_back(std::move(item));
+            notExpired.push_back(addr.m_walletID);
+            notContacts.push_back(addr.m_walletID);
+        }
+    }
+
+    m_activeAddresses.removeKeys(notActive);
+    m_expiredAddresses.removeKeys(notExpired);
+    m_contacts.removeKeys(notContacts);
+
+    scheduleExpiry(active);
+
+    m_activeAddresses.insertSorted(active);
+    m_expiredAddresses.insertSorted(expired);
+    m_contacts.insertSorted(contacts);
 }
 
 void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& transactions)
@@ -427,130 +365,65 @@ void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, con
     }
 }
 
-void AddressBookViewModel::timerEvent(QTimerEvent *event)
+void AddressBookViewModel::scheduleExpiry(const std::vector<AddressBookList::ItemPtr>& items)
 {
-    auto firstExpired = std::remove_if(
-        m_activeAddresses.begin(), m_activeAddresses.end(), 
-        [](const AddressItem* addr) { return addr->isExpired(); });
-
-    if (firstExpired != m_activeAddresses.end())
+    for (const auto& item : items)
     {
-        for (auto it = firstExpired; it != m_activeAddresses.end(); ++it)
+        if (!item->isNeverExpired())
         {
-            m_expiredAddresses.push_back(*it);
+            m_expiries.emplace(item->getExpirationTimestamp(), item->getAddress().m_walletID);
         }
-
-        m_activeAddresses.erase(firstExpired, m_activeAddresses.end());
-
-        emit activeAddressesChanged();
-        sortExpiredAddresses();
     }
+    restartExpiryTimer();
 }
 
-void AddressBookViewModel::getAddressesFromModel()
+void AddressBookViewModel::restartExpiryTimer()
 {
-    m_model.getAsync()->getAddresses(true);
-    m_model.getAsync()->getAddresses(false);
-}
-
-void AddressBookViewModel::sortActiveAddresses()
-{
-    auto cmp = generateAddrComparer(m_activeAddrSortRole, m_activeAddrSortOrder);
-    std::sort(m_activeAddresses.begin(), m_activeAddresses.end(), cmp);
-
-    emit activeAddressesChanged();
-}
-
-void AddressBookViewModel::sortExpiredAddresses()
-{
-    auto cmp = generateAddrComparer(m_expiredAddrSortRole, m_expiredAddrSortOrder);
-    std::sort(m_expiredAddresses.begin(), m_expiredAddresses.end(), cmp);
-
-    emit expiredAddressesChanged();
-}
-
-void AddressBookViewModel::sortContacts()
-{
-    auto cmp = generateContactComparer();
-    std::sort(m_contacts.begin(), m_contacts.end(), cmp);
+    if (m_expiries.empty())
+    {
+        m_expiryTimer.stop();
+        return;
+    }
 
-    emit contactsChanged();
+    // an address is expired one second after its expiration time
+    const auto now = beam::getTimestamp();
+    const auto next = m_expiries.top().first + 1;
+    const qint64 kMaxDelay = std::numeric_limits<int>::max();
+    const qint64 delay = next > now ? std::min(qint64(next - now) * 1000, kMaxDelay) : 0;
+    m_expiryTimer.start(static_cast<int>(delay));
 }
 
-std::function<bool(const AddressItem*, const AddressItem*)> AddressBookViewModel::generateAddrComparer(QString role, Qt::SortOrder order)
+void AddressBookViewModel::onExpiryTimer()
 {
-    if (role == nameRole())
-        return [sortOrder = order](const AddressItem* lf, const AddressItem* rt)
-    {
-        return compare(lf->getName(), rt->getName(), sortOrder);
-    };
-
-    if (role == tokenRole())
-        return [sortOrder = order](const AddressItem* lf, const AddressItem* rt)
-    {
-        return compare(lf->getToken(), rt->getToken(), sortOrder);
-    };
-
-    if (role == walletIDRole())
-        return [sortOrder = order](const AddressItem* lf, const AddressItem* rt)
-    {
-        return compare(lf->getWalletID(), rt->getWalletID(), sortOrder);
-    };
+    std::vector<AddressBookList::ItemPtr> expired;
+    std::vector<beam::wallet::WalletID> keys;
 
-    if (role == categoryRole())
-        return [sortOrder = order](const AddressItem* lf, const AddressItem* rt)
+    while (!m_expiries.empty())
     {
-        return compare(lf->getCategory(), rt->getCategory(), sortOrder);
-    };
+        const auto top = m_expiries.top();
+        const auto item = m_activeAddresses.find(top.second);
 
-    if (role == identityRole())
-        return [sortOrder = order](const AddressItem* lf, const AddressItem* rt)
-    {
-        return compare(lf->getIdentity(), rt->getIdentity(), sortOrder);
-    };
-
-    if (role == expirationRole())
-        return [sortOrder = order](const AddressItem* lf, const AddressItem* rt)
-    {
-        return compare(lf->getExpirationTimestamp(), rt->getExpirationTimestamp(), sortOrder);
-    };
+        // removed, extended or already moved addresses leave stale entries
+        const bool stale = !item || item->isNeverExpired() || item->getExpirationTimestamp() != top.first;
+        if (!stale)
+        {
+            if (!item->isExpired())
+            {
+                break;
+            }
+            expired.push_back(item);
+            keys.push_back(top.second);
+        }
+        m_expiries.pop();
+    }
 
-    // default for createdRole
-    return [sortOrder = order](const AddressItem* lf, const AddressItem* rt)
-    {
-        return compare(lf->getCreateTimestamp(), rt->getCreateTimestamp(), sortOrder);
-    };
+    m_activeAddresses.removeKeys(keys);
+    m_expiredAddresses.insertSorted(expired);
+    restartExpiryTimer();
 }
 
-std::function<bool(const ContactItem*, const ContactItem*)> AddressBookViewModel::generateContactComparer()
+void AddressBookViewModel::getAddressesFromModel()
 {
-    if (m_contactSortRole == walletIDRole())
-        return [sortOrder = m_contactSortOrder](const ContactItem* lf, const ContactItem* rt)
-    {
-        return compare(lf->getWalletID(), rt->getWalletID(), sortOrder);
-    };
-
-    if (m_contactSortRole == tokenRole())
-        return [sortOrder = m_contactSortOrder](const ContactItem* lf, const ContactItem* rt)
-    {
-        return compare(lf->getToken(), rt->getToken(), sortOrder);
-    };
-
-    if (m_contactSortRole == categoryRole())
-        return [sortOrder = m_contactSortOrder](const ContactItem* lf, const ContactItem* rt)
-    {
-        return compare(lf->getCategory(), rt->getCategory(), sortOrder);
-    };
-
-    if (m_contactSortRole == identityRole())
-        return [sortOrder = m_contactSortOrder](const ContactItem* lf, const ContactItem* rt)
-    {
-        return compare(lf->getIdentity(), rt->getIdentity(), sortOrder);
-    };
-
-    // default for nameRole
-    return [sortOrder = m_contactSortOrder](const ContactItem* lf, const ContactItem* rt)
-    {
-        return compare(lf->getName(), rt->getName(), sortOrder);
-    };
+    m_model.getAsync()->getAddresses(true);
+    m_model.getAsync()->getAddresses(false);
 }
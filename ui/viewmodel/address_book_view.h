@@ -18,74 +18,18 @@
 #include <QObject>
 #include <QtCore/qvariant.h>
 #include <QDateTime>
-#include <QQmlListProperty>
+#include <QTimer>
+#include <queue>
 #include "wallet/core/wallet_db.h"
 #include "model/wallet_model.h"
-
-class AddressItem : public QObject
-{
-    Q_OBJECT
-    Q_PROPERTY(QString   walletID         READ getWalletID       CONSTANT)
-    Q_PROPERTY(QString   token            READ getToken          CONSTANT)
-    Q_PROPERTY(QString   name             READ getName           CONSTANT)
-    Q_PROPERTY(QString   category         READ getCategory       CONSTANT)
-    Q_PROPERTY(QString   identity         READ getIdentity       CONSTANT)
-    Q_PROPERTY(QDateTime expirationDate   READ getExpirationDate CONSTANT)
-    Q_PROPERTY(QDateTime createDate       READ getCreateDate     CONSTANT)
-    Q_PROPERTY(bool      neverExpired     READ isNeverExpired    CONSTANT)
-    Q_PROPERTY(bool      isExpired        READ isExpired         CONSTANT)
-
-public:
-
-    AddressItem() = default;
-    AddressItem(beam::wallet::WalletAddress);
-
-    QString getWalletID() const;
-    QString getToken() const;
-    QString getName() const;
-    QString getCategory() const;
-    QString getIdentity() const;
-    QDateTime getExpirationDate() const;
-    QDateTime getCreateDate() const;
-    bool isNeverExpired() const;
-
-    bool isExpired() const;
-    beam::Timestamp getCreateTimestamp() const;
-    beam::Timestamp getExpirationTimestamp() const;
-
-private:
-    beam::wallet::WalletAddress m_walletAddress;
-};
-
-class ContactItem : public QObject
-{
-    Q_OBJECT
-    Q_PROPERTY(QString walletID      READ getWalletID   CONSTANT)
-    Q_PROPERTY(QString name          READ getName       CONSTANT)
-    Q_PROPERTY(QString category      READ getCategory   CONSTANT)
-    Q_PROPERTY(QString identity      READ getIdentity   CONSTANT)
-    Q_PROPERTY(QString token         READ getToken      CONSTANT)
-
-public:
-    ContactItem() = default;
-    ContactItem(const beam::wallet::WalletAddress&);
-
-    QString getWalletID() const;
-    QString getName() const;
-    QString getCategory() const;
-    QString getIdentity() const;
-    QString getToken() const;
-
-private:
-    beam::wallet::WalletAddress m_walletAddress;
-};
+#include "address_book_list.h"
 
 class AddressBookViewModel : public QObject
 {
     Q_OBJECT
-    Q_PROPERTY(QQmlListProperty<ContactItem> contacts          READ getContacts          NOTIFY contactsChanged)
-    Q_PROPERTY(QQmlListProperty<AddressItem> activeAddresses   READ getActiveAddresses   NOTIFY activeAddressesChanged)
-    Q_PROPERTY(QQmlListProperty<AddressItem> expiredAddresses  READ getExpiredAddresses  NOTIFY expiredAddressesChanged)
+    Q_PROPERTY(QAbstractItemModel* contacts          READ getContacts          CONSTANT)
+    Q_PROPERTY(QAbstractItemModel* activeAddresses   READ getActiveAddresses   CONSTANT)
+    Q_PROPERTY(QAbstractItemModel* expiredAddresses  READ getExpiredAddresses  CONSTANT)
 
     Q_PROPERTY(QString nameRole READ nameRole CONSTANT)
     Q_PROPERTY(QString tokenRole READ tokenRole CONSTANT)
@@ -112,11 +56,10 @@ public:
 
 public:
     AddressBookViewModel();
-    ~AddressBookViewModel();
 
-    QQmlListProperty<ContactItem> getContacts();
-    QQmlListProperty<AddressItem> getActiveAddresses();
-    QQmlListProperty<AddressItem> getExpiredAddresses();
+    QAbstractItemModel* getContacts();
+    QAbstractItemModel* getActiveAddresses();
+    QAbstractItemModel* getExpiredAddresses();
 
     [[nodiscard]] QString nameRole() const;
     [[nodiscard]] QString walletIDRole() const;
@@ -145,28 +88,19 @@ public slots:
     void onTransactions(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&);
     void onAddressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>& addresses);
 
-signals:
-    void contactsChanged();
-    void activeAddressesChanged();
-    void expiredAddressesChanged();
-
-protected:
-    void timerEvent(QTimerEvent *event) override;
-
 private:
     void getAddressesFromModel();
-    void sortActiveAddresses();
-    void sortExpiredAddresses();
-    void sortContacts();
 
-    std::function<bool(const AddressItem*, const AddressItem*)> generateAddrComparer(QString, Qt::SortOrder);
-    std::function<bool(const ContactItem*, const ContactItem*)> generateContactComparer();
+    // active addresses are moved to expired exactly when they expire
+    void scheduleExpiry(const std::vector<AddressBookList::ItemPtr>& items);
+    void restartExpiryTimer();
+    void onExpiryTimer();
 
 private:
     WalletModel& m_model;
-    QList<ContactItem*> m_contacts;
-    QList<AddressItem*> m_activeAddresses;
-    QList<AddressItem*> m_expiredAddresses;
+    AddressBookList m_contacts;
+    AddressBookList m_activeAddresses;
+    AddressBookList m_expiredAddresses;
     Qt::SortOrder m_activeAddrSortOrder = Qt::AscendingOrder;
     Qt::SortOrder m_expiredAddrSortOrder = Qt::AscendingOrder;
     Qt::SortOrder m_contactSortOrder = Qt::AscendingOrder;
@@ -174,4 +108,9 @@ private:
     QString m_expiredAddrSortRole;
     QString m_contactSortRole;
     std::vector<beam::wallet::WalletID> m_busyAddresses;
+
+    // min-heap of expiration times, stale entries are skipped when popped
+    using Expiry = std::pair<beam::Timestamp, beam::wallet::WalletID>;
+    std::priority_queue<Expiry, std::vector<Expiry>, std::greater<Expiry>> m_expiries;
+    QTimer m_expiryTimer;
 };
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "swap_offer_item.h"
+#include <cmath>
 #include "utility/helpers.h"
 #include "wallet/core/common.h"
 #include "viewmodel/ui_helpers.h"
@@ -74,6 +75,20 @@ QString SwapOfferItem::rate() const
         beamui::getCurrencyDecimals(getSwapCoinType()));
 }
 
+double SwapOfferItem::rawRate() const
+{
+    beam::Amount otherCoinAmount =
+        isSendBeam() ? rawAmountReceive() : rawAmountSend();
+    beam::Amount beamAmount =
+        isSendBeam() ? rawAmountSend() : rawAmountReceive();
+
+    if (!beamAmount) return 0;
+
+    // whole coins per whole beam, the same value rate() shows
+    const int decimalsDiff = beamui::getCurrencyDecimals(beamui::Currencies::Beam) - beamui::getCurrencyDecimals(getSwapCoinType());
+    return static_cast<double>(otherCoinAmount) / static_cast<double>(beamAmount) * std::pow(10.0, decimalsDiff);
+}
+
 QString SwapOfferItem::amountSend() const
 {
     auto coinType = isSendBeam() ? beamui::Currencies::Beam : getSwapCoinType();
@@ -116,6 +131,11 @@ QString SwapOfferItem::getSwapCoinName() const
     return toString(getSwapCoinType());
 }
 
+beam::wallet::AtomicSwapCoin SwapOfferItem::getSwapCoin() const
+{
+    return m_offer.swapCoinType();
+}
+
 void SwapOfferItem::reset(const beam::wallet::SwapOffer& offer)
 {
     m_offer = offer;
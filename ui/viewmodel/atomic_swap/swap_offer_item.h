@@ -33,6 +33,7 @@ public:
     QString amountSend() const;
     QString amountReceive() const;
     QString rate() const;
+    double rawRate() const;
     bool isOwnOffer() const;
     bool isSendBeam() const;
 
@@ -42,6 +43,7 @@ public:
     beam::wallet::TxParameters getTxParameters() const;
     beam::wallet::TxID getTxID() const;
     QString getSwapCoinName() const;
+    beam::wallet::AtomicSwapCoin getSwapCoin() const;
 protected:
     void reset(const beam::wallet::SwapOffer& offer);
 
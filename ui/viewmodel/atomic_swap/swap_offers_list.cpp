@@ -18,6 +18,58 @@ SwapOffersList::SwapOffersList()
 {
 }
 
+beam::wallet::TxID SwapOffersList::keyOf(const std::shared_ptr<SwapOfferItem>& item) const
+{
+    return item->getTxID();
+}
+
+const SwapOrderBook* SwapOffersList::getOrderBook(beam::wallet::AtomicSwapCoin swapCoin) const
+{
+    auto it = m_orderBooks.find(swapCoin);
+    return it != m_orderBooks.end() ? &it->second : nullptr;
+}
+
+void SwapOffersList::onItemAdded(const std::shared_ptr<SwapOfferItem>& item)
+{
+    const bool isSendBeam = item->isSendBeam();
+    const auto beamAmount = isSendBeam ? item->rawAmountSend() : item->rawAmountReceive();
+    if (!beamAmount)
+    {
+        return;
+    }
+
+    // prices are rounded to the smallest unit of the swap coin
+    const auto swapCoin = item->getSwapCoin();
+    auto book = m_orderBooks.find(swapCoin);
+    if (book == m_orderBooks.end())
+    {
+        const auto decimals = beamui::getCurrencyDecimals(beamui::convertSwapCoinToCurrency(swapCoin));
+        book = m_orderBooks.emplace(swapCoin, SwapOrderBook(decimals)).first;
+    }
+
+    // we'd send beams to the maker, so the maker buys beam: that is a bid
+    const auto otherAmount = isSendBeam ? item->rawAmountReceive() : item->rawAmountSend();
+    book->second.insert(item->getTxID(), isSendBeam, item->rawRate(), beamAmount, otherAmount);
+}
+
+void SwapOffersList::onItemRemoved(const std::shared_ptr<SwapOfferItem>& item)
+{
+    auto it = m_orderBooks.find(item->getSwapCoin());
+    if (it != m_orderBooks.end())
+    {
+        it->second.remove(item->getTxID());
+    }
+}
+
+void SwapOffersList::onItemsCleared()
+{
+    // books are cleared rather than dropped to keep their versions growing
+    for (auto& p : m_orderBooks)
+    {
+        p.second.clear();
+    }
+}
+
 QHash<int, QByteArray> SwapOffersList::roleNames() const
 {
     static const auto roles = QHash<int, QByteArray>
@@ -71,9 +123,11 @@ QVariant SwapOffersList::data(const QModelIndex &index, int role) const
             return static_cast<qulonglong>(value->rawAmountReceive());
 
         case Roles::Rate:
-        case Roles::RateSort:
             return value->rate();
 
+        case Roles::RateSort:
+            return value->rawRate();
+
         case Roles::Expiration:
             return value->timeExpiration().toString(m_locale.dateTimeFormat(QLocale::ShortFormat));
         case Roles::ExpirationSort:
@@ -16,8 +16,14 @@
 
 #include "swap_offer_item.h"
 #include "viewmodel/helpers/list_model.h"
+#include "viewmodel/helpers/order_book.h"
 #include <QLocale>
-class SwapOffersList : public ListModel<std::shared_ptr<SwapOfferItem>>
+#include <map>
+
+// Offers of one swap coin against beam, beam is the base of the pair
+using SwapOrderBook = OrderBook<beam::wallet::TxID, BlobKeyHash>;
+
+class SwapOffersList : public KeyedListModel<std::shared_ptr<SwapOfferItem>, beam::wallet::TxID, BlobKeyHash>
 {
 
     Q_OBJECT
@@ -48,6 +54,15 @@ public:
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+    const SwapOrderBook* getOrderBook(beam::wallet::AtomicSwapCoin swapCoin) const;
+
 private:
+    beam::wallet::TxID keyOf(const std::shared_ptr<SwapOfferItem>& item) const override;
+    void onItemAdded(const std::shared_ptr<SwapOfferItem>& item) override;
+    void onItemRemoved(const std::shared_ptr<SwapOfferItem>& item) override;
+    void onItemsCleared() override;
+
+    std::map<beam::wallet::AtomicSwapCoin, SwapOrderBook> m_orderBooks;
+
     QLocale m_locale; // default
 };
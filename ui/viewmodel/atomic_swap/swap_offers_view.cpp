@@ -11,6 +11,7 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <limits>
 #include <qdebug.h>
 #include "model/app_model.h"
 #include "model/settings.h"
@@ -198,13 +199,12 @@ beam::Amount SwapCoinClientWrapper::getAvailable() const
 
 SwapOffersViewModel::SwapOffersViewModel()
     :   m_walletModel{*AppModel::getInstance().getWalletModel()}
+    ,   m_txView{AppModel::getInstance().getTransactions()->makeView({beam::wallet::TxType::AtomicSwap})}
 {
     InitSwapClientWrappers();
 
     connect(&m_walletModel, &WalletModel::walletStatusChanged, this, &SwapOffersViewModel::beamAvailableChanged);
-    connect(&m_walletModel,
-            SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)),
-            SLOT(onTransactionsDataModelChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)));
+    connect(m_txView.get(), &TransactionsView::transactionsChanged, this, &SwapOffersViewModel::onTransactionsDataModelChanged);
 
     connect(&m_walletModel,
             SIGNAL(swapOffersChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::SwapOffer>&)),
@@ -213,7 +213,16 @@ SwapOffersViewModel::SwapOffersViewModel()
     monitorAllOffersFitBalance();
 
     m_walletModel.getAsync()->getSwapOffers();
-    m_walletModel.getAsync()->getTransactions();    
+
+    auto store = AppModel::getInstance().getTransactions();
+    if (store->isLoaded())
+    {
+        onTransactionsDataModelChanged(beam::wallet::ChangeAction::Reset, store->getByType(m_txView->types()));
+    }
+    else
+    {
+        store->load();
+    }
 }
 
 SwapOffersViewModel::~SwapOffersViewModel()
@@ -231,6 +240,61 @@ QAbstractItemModel* SwapOffersViewModel::getAllOffersFitBalance()
     return &m_offersListFitBalance;
 }
 
+QAbstractItemModel* SwapOffersViewModel::getOrderBook()
+{
+    return &m_orderBook;
+}
+
+OldWalletCurrency::OldCurrency SwapOffersViewModel::getOrderBookCurrency() const
+{
+    return convertSwapCoinToCurrency(m_orderBookCoin);
+}
+
+void SwapOffersViewModel::setOrderBookCurrency(OldWalletCurrency::OldCurrency currency)
+{
+    const auto swapCoin = convertCurrencyToSwapCoin(currency);
+    if (swapCoin != m_orderBookCoin)
+    {
+        m_orderBookCoin = swapCoin;
+        refreshOrderBook();
+    }
+}
+
+QString SwapOffersViewModel::getBestBid() const
+{
+    return getBestPrice(true);
+}
+
+QString SwapOffersViewModel::getBestAsk() const
+{
+    return getBestPrice(false);
+}
+
+QString SwapOffersViewModel::getBestPrice(bool isBid) const
+{
+    std::optional<double> price;
+    if (auto book = m_offersList.getOrderBook(m_orderBookCoin))
+    {
+        price = book->bestPrice(isBid);
+    }
+
+    if (!price)
+    {
+        return QString();
+    }
+
+    const auto decimals = beamui::getCurrencyDecimals(beamui::convertSwapCoinToCurrency(m_orderBookCoin));
+    return QString::number(*price, 'f', decimals);
+}
+
+void SwapOffersViewModel::refreshOrderBook()
+{
+    if (m_orderBook.refresh(m_orderBookCoin, m_offersList.getOrderBook(m_orderBookCoin)))
+    {
+        emit orderBookChanged();
+    }
+}
+
 QString SwapOffersViewModel::beamAvailable() const
 {
     auto available = beam::AmountBig::get_Lo(m_walletModel.getAvailable(beam::Asset::s_BeamID));
@@ -289,24 +353,22 @@ void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAct
     std::vector<std::shared_ptr<SwapTxObject>> inactiveTransactions;
     swapTransactions.reserve(transactions.size());
 
+    // the view passes atomic swaps only
     for (const auto& t : transactions)
     {
-        if (t.GetParameter<TxType>(TxParameterID::TransactionType) == TxType::AtomicSwap)
+        auto swapCoinType = t.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
+        uint32_t lockTxMinConfirmations = swapCoinType ? getLockTxMinConfirmations(*swapCoinType) : 0;
+        uint32_t withdrawTxMinConfirmations = swapCoinType ? getWithdrawTxMinConfirmations(*swapCoinType) : 0;
+        double blocksPerHour = swapCoinType ? getBlocksPerHour(*swapCoinType) : 0;
+        auto newItem = std::make_shared<SwapTxObject>(t, lockTxMinConfirmations, withdrawTxMinConfirmations, blocksPerHour);
+        swapTransactions.push_back(newItem);
+        if (!newItem->isPending() && newItem->isInProgress())
         {
-            auto swapCoinType = t.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
-            uint32_t lockTxMinConfirmations = swapCoinType ? getLockTxMinConfirmations(*swapCoinType) : 0;
-            uint32_t withdrawTxMinConfirmations = swapCoinType ? getWithdrawTxMinConfirmations(*swapCoinType) : 0;
-            double blocksPerHour = swapCoinType ? getBlocksPerHour(*swapCoinType) : 0;
-            auto newItem = std::make_shared<SwapTxObject>(t, lockTxMinConfirmations, withdrawTxMinConfirmations, blocksPerHour);
-            swapTransactions.push_back(newItem);
-            if (!newItem->isPending() && newItem->isInProgress())
-            {
-                activeTransactions.push_back(newItem);
-            }
-            else
-            {
-                inactiveTransactions.push_back(newItem);
-            }
+            activeTransactions.push_back(newItem);
+        }
+        else
+        {
+            inactiveTransactions.push_back(newItem);
         }
     }
 
@@ -424,14 +486,38 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(beam::wallet::ChangeActio
         case ChangeAction::Reset:
             {
                 m_offersList.reset(modifiedOffers);
-                resetAllOffersFitBalance();
+
+                m_fitBuckets.clear();
+                m_fitPositions.clear();
+                m_offersListFitBalance.reset(indexOffersFitBalance(modifiedOffers));
+                emit allOffersFitBalanceChanged();
                 break;
             }
 
         case ChangeAction::Added:
             {
                 m_offersList.insert(modifiedOffers);
-                insertAllOffersFitBalance(modifiedOffers);
+
+                unindexOffersFitBalance(modifiedOffers);
+                const auto fitOffers = indexOffersFitBalance(modifiedOffers);
+
+                // an updated offer may not fit anymore, its old row has to go.
+                // Fitting offers come back in the same order, so one pass is enough
+                std::vector<beam::wallet::TxID> notFit;
+                auto fit = fitOffers.begin();
+                for (const auto& offer : modifiedOffers)
+                {
+                    if (fit != fitOffers.end() && *fit == offer)
+                    {
+                        ++fit;
+                        continue;
+                    }
+                    notFit.push_back(offer->getTxID());
+                }
+
+                m_offersListFitBalance.removeKeys(notFit);
+                m_offersListFitBalance.insert(fitOffers);
+                emit allOffersFitBalanceChanged();
                 break;
             }
 
@@ -443,7 +529,10 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(beam::wallet::ChangeActio
                         QVariant::fromValue(modifiedOffer->getTxID()));
                 }
                 m_offersList.remove(modifiedOffers);
-                removeAllOffersFitBalance(modifiedOffers);
+
+                unindexOffersFitBalance(modifiedOffers);
+                m_offersListFitBalance.remove(modifiedOffers);
+                emit allOffersFitBalanceChanged();
                 break;
             }
         
@@ -453,22 +542,59 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(beam::wallet::ChangeActio
     }
     
     emit allOffersChanged();
+    refreshOrderBook();
     setIsOffersLoaded(true);
 }
 
-void SwapOffersViewModel::resetAllOffersFitBalance()
+void SwapOffersViewModel::updateOffersFitBalance()
 {
-    auto offersCount = m_offersList.rowCount();
-    std::vector<std::shared_ptr<SwapOfferItem>> offersListFitBalance;
-    offersListFitBalance.reserve(offersCount);
+    std::vector<std::shared_ptr<SwapOfferItem>> crossedIn;
+    std::vector<beam::wallet::TxID> crossedOut;
 
-    for(int i = 0; i < offersCount; ++i)
+    for (auto& p : m_fitBuckets)
     {
-        const auto&it = m_offersList.get(i);
-        if (isOfferFitBalance(*it))
-            offersListFitBalance.push_back(it);
+        auto& bucket = p.second;
+        const auto limit = getFitLimit(p.first);
+        if (limit == bucket.limit)
+        {
+            continue;
+        }
+
+        // only the offers between the old and the new limit have crossed it
+        auto endOf = [&bucket](const boost::optional<beam::Amount>& l)
+        {
+            return l ? bucket.offers.upper_bound(*l) : bucket.offers.begin();
+        };
+
+        auto oldEnd = endOf(bucket.limit);
+        auto newEnd = endOf(limit);
+        const bool grown = !bucket.limit || (limit && *limit > *bucket.limit);
+
+        if (grown)
+        {
+            for (auto it = oldEnd; it != newEnd; ++it)
+            {
+                crossedIn.push_back(it->second);
+            }
+        }
+        else
+        {
+            for (auto it = newEnd; it != oldEnd; ++it)
+            {
+                crossedOut.push_back(it->second->getTxID());
+            }
+        }
+
+        bucket.limit = limit;
     }
-    m_offersListFitBalance.reset(offersListFitBalance);
+
+    if (crossedIn.empty() && crossedOut.empty())
+    {
+        return;
+    }
+
+    m_offersListFitBalance.removeKeys(crossedOut);
+    m_offersListFitBalance.insert(crossedIn);
     emit allOffersFitBalanceChanged();
 }
 
@@ -504,71 +630,89 @@ int SwapOffersViewModel::getActiveTxCount() const
 
 void SwapOffersViewModel::monitorAllOffersFitBalance()
 {
-    connect(this, SIGNAL(beamAvailableChanged()), SLOT(resetAllOffersFitBalance()));
+    connect(this, SIGNAL(beamAvailableChanged()), SLOT(updateOffersFitBalance()));
 
     for (auto swapClientWrapper : m_swapClientWrappers)
     {
-        connect(swapClientWrapper, SIGNAL(availableChanged()), this, SLOT(resetAllOffersFitBalance()));
-        connect(swapClientWrapper, SIGNAL(statusChanged()), this, SLOT(resetAllOffersFitBalance()));
+        connect(swapClientWrapper, SIGNAL(availableChanged()), this, SLOT(updateOffersFitBalance()));
+        connect(swapClientWrapper, SIGNAL(statusChanged()), this, SLOT(updateOffersFitBalance()));
         connect(this, SIGNAL(allTransactionsChanged()), swapClientWrapper, SIGNAL(activeTxChanged()));
     }
 }
 
-// TODO: check logic
-bool SwapOffersViewModel::isOfferFitBalance(const SwapOfferItem& offer)
+boost::optional<beam::Amount> SwapOffersViewModel::getFitLimit(const FitKey& key) const
 {
-    if (offer.isOwnOffer())
-        return true;
-
-    bool isSendBeam = offer.isSendBeam();
-    beam::AmountBig::Type beamOfferAmount = isSendBeam ? offer.rawAmountSend() : offer.rawAmountReceive();
-
-    if (isSendBeam && beamOfferAmount > m_walletModel.getAvailable(beam::Asset::s_BeamID))
-        return false;
-    
-    auto swapCoinOfferAmount = isSendBeam ? offer.rawAmountReceive() : offer.rawAmountSend();
-    // TODO: find better solution to get AtomicSwapCoin
-    auto swapCoin = offer.getTxParameters().GetParameter<beam::wallet::AtomicSwapCoin>(beam::wallet::TxParameterID::AtomicSwapCoin);
-    auto swapCoinClientWrapper = getSwapCoinClientWrapper(*swapCoin);
+    auto swapCoinClientWrapper = getSwapCoinClientWrapper(key.first);
+    if (!swapCoinClientWrapper || !swapCoinClientWrapper->getIsConnected())
+    {
+        return boost::none;
+    }
 
-    if (swapCoinClientWrapper->getIsConnected())
+    if (key.second)
     {
-        return isSendBeam ? true : swapCoinOfferAmount <= swapCoinClientWrapper->getAvailable();
+        const auto available = m_walletModel.getAvailable(beam::Asset::s_BeamID);
+        const beam::AmountBig::Type maxAmount = std::numeric_limits<beam::Amount>::max();
+        return maxAmount < available ? std::numeric_limits<beam::Amount>::max() : beam::AmountBig::get_Lo(available);
     }
 
-    return false;
+    return swapCoinClientWrapper->getAvailable();
 }
 
-void SwapOffersViewModel::insertAllOffersFitBalance(
+std::vector<std::shared_ptr<SwapOfferItem>> SwapOffersViewModel::indexOffersFitBalance(
     const std::vector<std::shared_ptr<SwapOfferItem>>& offers)
 {
+    using namespace beam::wallet;
+
     std::vector<std::shared_ptr<SwapOfferItem>> fitBalanceOffers;
     fitBalanceOffers.reserve(offers.size());
 
-    std::copy_if(offers.begin(), offers.end(),
-                 std::back_inserter(fitBalanceOffers),
-                 [this] (const std::shared_ptr<SwapOfferItem>& it)
-                 {
-                     return isOfferFitBalance(*it);
-                 });
-    m_offersListFitBalance.insert(fitBalanceOffers);
-    emit allOffersFitBalanceChanged();
+    for (const auto& offer : offers)
+    {
+        if (offer->isOwnOffer())
+        {
+            fitBalanceOffers.push_back(offer);
+            continue;
+        }
+
+        // TODO: find better solution to get AtomicSwapCoin
+        auto swapCoin = offer->getTxParameters().GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
+        if (!swapCoin)
+        {
+            continue;
+        }
+
+        const FitKey key{*swapCoin, offer->isSendBeam()};
+        auto bucket = m_fitBuckets.find(key);
+        if (bucket == m_fitBuckets.end())
+        {
+            bucket = m_fitBuckets.emplace(key, FitBucket{{}, getFitLimit(key)}).first;
+        }
+
+        // the amount we send is either beams or the swap coin, the key tells which
+        const auto amount = offer->rawAmountSend();
+        m_fitPositions[offer->getTxID()] = {key, bucket->second.offers.emplace(amount, offer)};
+
+        if (bucket->second.limit && amount <= *bucket->second.limit)
+        {
+            fitBalanceOffers.push_back(offer);
+        }
+    }
+
+    return fitBalanceOffers;
 }
 
-void SwapOffersViewModel::removeAllOffersFitBalance(
+void SwapOffersViewModel::unindexOffersFitBalance(
     const std::vector<std::shared_ptr<SwapOfferItem>>& offers)
 {
-    std::vector<std::shared_ptr<SwapOfferItem>> fitBalanceOffers;
-    fitBalanceOffers.reserve(offers.size());
-
-    std::copy_if(offers.begin(), offers.end(),
-                 std::back_inserter(fitBalanceOffers),
-                 [this] (const std::shared_ptr<SwapOfferItem>& it)
-                 {
-                     return isOfferFitBalance(*it);
-                 });
-    m_offersListFitBalance.remove(fitBalanceOffers);
-    emit allOffersFitBalanceChanged();    
+    for (const auto& offer : offers)
+    {
+        auto it = m_fitPositions.find(offer->getTxID());
+        if (it != m_fitPositions.end())
+        {
+            m_fitBuckets[it->second.first].offers.erase(it->second.second);
+            m_fitPositions.erase(it);
+        }
+    }
 }
 
 bool SwapOffersViewModel::hasActiveTx(const std::string& swapCoin) const
@@ -13,13 +13,17 @@
 // limitations under the License.
 #pragma once
 
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <QObject>
 #include <QQmlListProperty>
 #include "model/wallet_model.h"
+#include "model/transactions_store.h"
 #include "model/swap_coin_client_model.h"
 #include "model/swap_eth_client_model.h"
 #include "swap_offers_list.h"
+#include "swap_order_book_list.h"
 #include "swap_tx_object_list.h"
 #include "viewmodel/currencies.h"
 
@@ -79,6 +83,10 @@ class SwapOffersViewModel : public QObject
     Q_PROPERTY(QAbstractItemModel*                       transactions        READ getTransactions        NOTIFY allTransactionsChanged)
     Q_PROPERTY(QAbstractItemModel*                       allOffers           READ getAllOffers           NOTIFY allOffersChanged)
     Q_PROPERTY(QAbstractItemModel*                       allOffersFitBalance READ getAllOffersFitBalance NOTIFY allOffersFitBalanceChanged)
+    Q_PROPERTY(QAbstractItemModel*                       orderBook           READ getOrderBook           CONSTANT)
+    Q_PROPERTY(OldWalletCurrency::OldCurrency            orderBookCurrency   READ getOrderBookCurrency   WRITE setOrderBookCurrency NOTIFY orderBookChanged)
+    Q_PROPERTY(QString                                   bestBid             READ getBestBid             NOTIFY orderBookChanged)
+    Q_PROPERTY(QString                                   bestAsk             READ getBestAsk             NOTIFY orderBookChanged)
     Q_PROPERTY(QString                                   beamAvailable       READ beamAvailable          NOTIFY beamAvailableChanged)
     Q_PROPERTY(bool                                      showBetaWarning     READ showBetaWarning)
     Q_PROPERTY(bool                                      isOffersLoaded      READ isOffersLoaded         NOTIFY offersLoaded)
@@ -92,6 +100,11 @@ public:
     QAbstractItemModel* getTransactions();
     QAbstractItemModel* getAllOffers();
     QAbstractItemModel* getAllOffersFitBalance();
+    QAbstractItemModel* getOrderBook();
+    OldWalletCurrency::OldCurrency getOrderBookCurrency() const;
+    void setOrderBookCurrency(OldWalletCurrency::OldCurrency currency);
+    QString getBestBid() const;
+    QString getBestAsk() const;
     QString beamAvailable() const;
     bool showBetaWarning() const;
     bool isOffersLoaded() const;
@@ -110,22 +123,36 @@ public slots:
     void onSwapOffersDataModelChanged(
         beam::wallet::ChangeAction action,
         const std::vector<beam::wallet::SwapOffer>& offers);
-    void resetAllOffersFitBalance();
+    void updateOffersFitBalance();
 
 signals:
     void allTransactionsChanged();
     void allOffersChanged();
     void allOffersFitBalanceChanged();
+    void orderBookChanged();
     void beamAvailableChanged();
     void offerRemovedFromTable(QVariant variantTxID);
     void offersLoaded();
 
 private:
+    // offers of other peers are indexed by swap coin, direction and the amount
+    // we would send, those up to the current balance of that side fit
+    using FitKey = std::pair<beam::wallet::AtomicSwapCoin, bool>;
+    using FitOffers = std::multimap<beam::Amount, std::shared_ptr<SwapOfferItem>>;
+
+    struct FitBucket
+    {
+        FitOffers offers;
+        boost::optional<beam::Amount> limit; // none while the swap client is offline
+    };
+
     void monitorAllOffersFitBalance();
-    bool isOfferFitBalance(const SwapOfferItem& offer);
-    void insertAllOffersFitBalance(
+    void refreshOrderBook();
+    QString getBestPrice(bool isBid) const;
+    boost::optional<beam::Amount> getFitLimit(const FitKey& key) const;
+    std::vector<std::shared_ptr<SwapOfferItem>> indexOffersFitBalance(
         const std::vector<std::shared_ptr<SwapOfferItem>>& offers);
-    void removeAllOffersFitBalance(
+    void unindexOffersFitBalance(
         const std::vector<std::shared_ptr<SwapOfferItem>>& offers);
     bool hasActiveTx(const std::string& swapCoin) const;
     void InitSwapClientWrappers();
@@ -140,10 +167,15 @@ private:
     void setIsOffersLoaded(bool isOffersLoaded);
 
     WalletModel& m_walletModel;
+    TransactionsView::Ptr m_txView;
 
     SwapTxObjectList m_transactionsList;
     SwapOffersList m_offersList;
     SwapOffersList m_offersListFitBalance;
+    std::map<FitKey, FitBucket> m_fitBuckets;
+    SwapOrderBookList m_orderBook;
+    beam::wallet::AtomicSwapCoin m_orderBookCoin = beam::wallet::AtomicSwapCoin::Bitcoin;
+    std::unordered_map<beam::wallet::TxID, std::pair<FitKey, FitOffers::iterator>, BlobKeyHash> m_fitPositions;
     QList<SwapCoinClientWrapper*> m_swapClientWrappers;
 
     int m_activeTxCount = 0;
@@ -0,0 +1,145 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "swap_order_book_list.h"
+#include <unordered_set>
+#include "viewmodel/ui_helpers.h"
+
+namespace
+{
+    // bids first, each side from its best price outwards
+    bool isAbove(const OrderBookLevel& left, const OrderBookLevel& right)
+    {
+        if (left.isBid != right.isBid)
+        {
+            return left.isBid;
+        }
+        return left.isBid ? left.ticks > right.ticks : left.ticks < right.ticks;
+    }
+}
+
+SwapOrderBookList::SwapOrderBookList()
+{
+}
+
+uint64_t SwapOrderBookList::keyOf(const OrderBookLevel& level) const
+{
+    return level.key();
+}
+
+QHash<int, QByteArray> SwapOrderBookList::roleNames() const
+{
+    static const auto roles = QHash<int, QByteArray>
+    {
+        { static_cast<int>(Roles::IsBid), "isBid" },
+        { static_cast<int>(Roles::Price), "price" },
+        { static_cast<int>(Roles::PriceSort), "priceSort" },
+        { static_cast<int>(Roles::Amount), "amount" },
+        { static_cast<int>(Roles::AmountSort), "amountSort" },
+        { static_cast<int>(Roles::Total), "total" },
+        { static_cast<int>(Roles::TotalSort), "totalSort" },
+        { static_cast<int>(Roles::Count), "count" }
+    };
+    return roles;
+}
+
+QVariant SwapOrderBookList::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_list.size())
+    {
+       return QVariant();
+    }
+
+    const auto& level = m_list[index.row()];
+    const auto swapCurrency = beamui::convertSwapCoinToCurrency(m_swapCoin);
+
+    switch (static_cast<Roles>(role))
+    {
+        case Roles::IsBid:
+            return level.isBid;
+
+        case Roles::Price:
+            return QString::number(level.price, 'f', beamui::getCurrencyDecimals(swapCurrency));
+
+        case Roles::PriceSort:
+            return level.price;
+
+        case Roles::Amount:
+            return beamui::AmountToUIString(level.size, beamui::Currencies::Beam);
+
+        case Roles::AmountSort:
+            return static_cast<qulonglong>(level.size);
+
+        case Roles::Total:
+            return beamui::AmountToUIString(level.total, swapCurrency);
+
+        case Roles::TotalSort:
+            return static_cast<qulonglong>(level.total);
+
+        case Roles::Count:
+            return level.count;
+
+        default:
+            return QVariant();
+    }
+}
+
+bool SwapOrderBookList::refresh(beam::wallet::AtomicSwapCoin swapCoin, const SwapOrderBook* book)
+{
+    const auto version = book ? book->version() : 0;
+    if (swapCoin == m_swapCoin && m_version && *m_version == version)
+    {
+        return false;
+    }
+
+    if (swapCoin != m_swapCoin)
+    {
+        // prices of another coin, nothing to keep
+        m_swapCoin = swapCoin;
+        reset({});
+    }
+    m_version = version;
+
+    std::vector<OrderBookLevel> levels;
+    if (book)
+    {
+        levels = book->depth(true);
+        const auto asks = book->depth(false);
+        levels.insert(levels.end(), asks.begin(), asks.end());
+    }
+
+    std::unordered_set<uint64_t> keys;
+    std::vector<OrderBookLevel> changed;
+    for (const auto& level : levels)
+    {
+        keys.insert(level.key());
+
+        const auto row = indexOf(level.key());
+        if (row < 0)
+        {
+            changed.push_back(level);
+            continue;
+        }
+
+        const auto& shown = m_list[row];
+        if (shown.size != level.size || shown.total != level.total || shown.count != level.count)
+        {
+            changed.push_back(level);
+        }
+    }
+
+    retain(keys);
+    insertSorted(changed, isAbove);
+    return true;
+}
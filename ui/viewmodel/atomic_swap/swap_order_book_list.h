@@ -0,0 +1,52 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "swap_offers_list.h"
+
+// Aggregated price levels of one swap coin, bids from the best price down,
+// then asks from the best price up. Levels are keyed by side and rounded
+// price, so a refresh only touches the levels that changed
+class SwapOrderBookList : public KeyedListModel<OrderBookLevel, uint64_t>
+{
+    Q_OBJECT
+
+public:
+    enum class Roles
+    {
+        IsBid = Qt::UserRole + 1,
+        Price,
+        PriceSort,
+        Amount,
+        AmountSort,
+        Total,
+        TotalSort,
+        Count
+    };
+
+    SwapOrderBookList();
+
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // applies the book when it changed since the last call
+    bool refresh(beam::wallet::AtomicSwapCoin swapCoin, const SwapOrderBook* book);
+
+private:
+    uint64_t keyOf(const OrderBookLevel& level) const override;
+
+    beam::wallet::AtomicSwapCoin m_swapCoin = beam::wallet::AtomicSwapCoin::Unknown;
+    std::optional<uint64_t> m_version;
+};
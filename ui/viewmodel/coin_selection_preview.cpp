@@ -0,0 +1,54 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "coin_selection_preview.h"
+#include "fee_helpers.h"
+#include <algorithm>
+
+CoinSelectionPreview::CoinSelectionPreview(WalletModel& model)
+{
+    connect(&model, &WalletModel::normalCoinsChanged,  this, &CoinSelectionPreview::onNormalCoinsChanged);
+    connect(&model, &WalletModel::shieldedCoinChanged, this, &CoinSelectionPreview::onShieldedCoinChanged);
+    model.getAsync()->getAllUtxosStatus();
+}
+
+CoinSelectionPreview::Result CoinSelectionPreview::calculate(beam::Amount requested, beam::Asset::ID assetId, bool isShielded) const
+{
+    return _coins.calculate(requested, assetId, estimateFee(isShielded));
+}
+
+void CoinSelectionPreview::reconcile(const beam::wallet::CoinsSelectionInfo& csi, bool isShielded)
+{
+    if (csi.m_requestedSum != 0)
+    {
+        _lastFee[isShielded] = csi.get_TotalFee();
+    }
+}
+
+void CoinSelectionPreview::onNormalCoinsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& coins)
+{
+    _coins.applyNormal(action, coins);
+    emit coinsChanged();
+}
+
+void CoinSelectionPreview::onShieldedCoinChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::ShieldedCoin>& coins)
+{
+    _coins.applyShielded(action, coins);
+    emit coinsChanged();
+}
+
+beam::Amount CoinSelectionPreview::estimateFee(bool isShielded) const
+{
+    return std::max(_lastFee[isShielded], minFeeBeam(isShielded));
+}
@@ -0,0 +1,48 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+#include "model/wallet_model.h"
+#include "coin_selection_snapshot.h"
+
+// Estimates coin selection on the UI thread from a snapshot of available coins.
+// The result is only a preview, the wallet's own selection stays authoritative
+class CoinSelectionPreview : public QObject
+{
+    Q_OBJECT
+public:
+    using Result = CoinSelectionSnapshot::Result;
+
+    explicit CoinSelectionPreview(WalletModel& model);
+
+    [[nodiscard]] Result calculate(beam::Amount requested, beam::Asset::ID assetId, bool isShielded) const;
+
+    // Keeps the fee of the last authoritative selection for later estimates
+    void reconcile(const beam::wallet::CoinsSelectionInfo& csi, bool isShielded);
+
+signals:
+    void coinsChanged();
+
+private slots:
+    void onNormalCoinsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& coins);
+    void onShieldedCoinChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::ShieldedCoin>& coins);
+
+private:
+    [[nodiscard]] beam::Amount estimateFee(bool isShielded) const;
+
+    CoinSelectionSnapshot _coins;
+    beam::Amount _lastFee[2] = {0, 0};
+};
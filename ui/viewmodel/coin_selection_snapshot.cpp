@@ -0,0 +1,180 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "coin_selection_snapshot.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace
+{
+    beam::Amount addSaturated(beam::Amount a, beam::Amount b)
+    {
+        return a > std::numeric_limits<beam::Amount>::max() - b ? std::numeric_limits<beam::Amount>::max() : a + b;
+    }
+}
+
+void CoinSelectionSnapshot::applyNormal(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& coins)
+{
+    applyChanges(&Bucket::normal, action, coins, [](const beam::wallet::Coin& coin, uint64_t& key, beam::Asset::ID& assetId, beam::Amount& amount)
+    {
+        ECC::Hash::Value hv;
+        coin.m_ID.get_Hash(hv);
+        key = *reinterpret_cast<const uint64_t*>(hv.m_pData);
+        assetId = coin.m_ID.m_AssetID;
+        amount = coin.m_ID.m_Value;
+        return coin.m_status == beam::wallet::Coin::Available;
+    });
+}
+
+void CoinSelectionSnapshot::applyShielded(beam::wallet::ChangeAction action, const std::vector<beam::wallet::ShieldedCoin>& coins)
+{
+    applyChanges(&Bucket::shielded, action, coins, [](const beam::wallet::ShieldedCoin& coin, beam::TxoID& key, beam::Asset::ID& assetId, beam::Amount& amount)
+    {
+        key = coin.m_TxoID;
+        assetId = coin.m_CoinID.m_AssetID;
+        amount = coin.m_CoinID.m_Value;
+        return coin.m_Status == beam::wallet::ShieldedCoin::Available;
+    });
+}
+
+CoinSelectionSnapshot::Result CoinSelectionSnapshot::calculate(beam::Amount requested, beam::Asset::ID assetId, beam::Amount fee) const
+{
+    Result res;
+    res.fee = fee;
+
+    beam::Amount selected = 0;
+    if (assetId == beam::Asset::s_BeamID)
+    {
+        const auto target = addSaturated(requested, res.fee);
+        res.isEnough = select(assetId, target, selected);
+        res.changeBeam = res.isEnough ? selected - target : 0;
+
+        const auto available = total(assetId);
+        res.maxAmount = available > res.fee ? available - res.fee : 0;
+        return res;
+    }
+
+    const bool enoughAsset = select(assetId, requested, selected);
+    res.changeAsset = enoughAsset ? selected - requested : 0;
+
+    const bool enoughBeam = select(beam::Asset::s_BeamID, res.fee, selected);
+    res.changeBeam = enoughBeam ? selected - res.fee : 0;
+
+    res.isEnough = enoughAsset && enoughBeam;
+    res.maxAmount = total(assetId);
+    return res;
+}
+
+template <typename Key, typename Coin, typename Describe>
+void CoinSelectionSnapshot::applyChanges(std::unordered_map<Key, beam::Amount> Bucket::*coinsOf,
+                                         beam::wallet::ChangeAction action,
+                                         const std::vector<Coin>& coins,
+                                         Describe&& describe)
+{
+    using namespace beam::wallet;
+
+    if (action == ChangeAction::Reset)
+    {
+        for (auto& p : _buckets)
+        {
+            (p.second.*coinsOf).clear();
+            p.second.dirty = true;
+        }
+    }
+
+    for (const auto& coin : coins)
+    {
+        Key key = 0;
+        beam::Asset::ID assetId = 0;
+        beam::Amount amount = 0;
+        const bool available = describe(coin, key, assetId, amount);
+
+        auto& bucket = _buckets[assetId];
+        bucket.dirty = true;
+
+        if (action != ChangeAction::Removed && available)
+        {
+            (bucket.*coinsOf)[key] = amount;
+        }
+        else
+        {
+            (bucket.*coinsOf).erase(key);
+        }
+    }
+}
+
+const std::vector<beam::Amount>& CoinSelectionSnapshot::sumsOf(beam::Asset::ID assetId) const
+{
+    static const std::vector<beam::Amount> empty;
+
+    auto it = _buckets.find(assetId);
+    if (it == _buckets.end())
+    {
+        return empty;
+    }
+
+    const auto& bucket = it->second;
+    if (bucket.dirty)
+    {
+        std::vector<beam::Amount> amounts;
+        amounts.reserve(bucket.normal.size() + bucket.shielded.size());
+        for (const auto& p : bucket.normal)
+        {
+            amounts.push_back(p.second);
+        }
+        for (const auto& p : bucket.shielded)
+        {
+            amounts.push_back(p.second);
+        }
+        std::sort(amounts.begin(), amounts.end(), std::greater<beam::Amount>());
+
+        bucket.sums.resize(amounts.size());
+        beam::Amount sum = 0;
+        for (size_t i = 0; i < amounts.size(); ++i)
+        {
+            sum = addSaturated(sum, amounts[i]);
+            bucket.sums[i] = sum;
+        }
+        bucket.dirty = false;
+    }
+
+    return bucket.sums;
+}
+
+bool CoinSelectionSnapshot::select(beam::Asset::ID assetId, beam::Amount target, beam::Amount& selected) const
+{
+    if (target == 0)
+    {
+        selected = 0;
+        return true;
+    }
+
+    const auto& sums = sumsOf(assetId);
+    auto it = std::lower_bound(sums.begin(), sums.end(), target);
+    if (it == sums.end())
+    {
+        selected = 0;
+        return false;
+    }
+
+    selected = *it;
+    return true;
+}
+
+beam::Amount CoinSelectionSnapshot::total(beam::Asset::ID assetId) const
+{
+    const auto& sums = sumsOf(assetId);
+    return sums.empty() ? 0 : sums.back();
+}
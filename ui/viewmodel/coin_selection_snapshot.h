@@ -0,0 +1,67 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "wallet/core/wallet_db.h"
+
+// Available coins of every asset, kept up to date from coin changes.
+// Selection takes the largest coins first, that is the fewest inputs covering the target
+class CoinSelectionSnapshot
+{
+public:
+    struct Result
+    {
+        beam::Amount fee         = 0;
+        beam::Amount changeBeam  = 0;
+        beam::Amount changeAsset = 0;
+        beam::Amount maxAmount   = 0;
+        bool         isEnough    = false;
+    };
+
+    void applyNormal(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& coins);
+    void applyShielded(beam::wallet::ChangeAction action, const std::vector<beam::wallet::ShieldedCoin>& coins);
+
+    // fee is paid in beams whatever asset is sent
+    [[nodiscard]] Result calculate(beam::Amount requested, beam::Asset::ID assetId, beam::Amount fee) const;
+
+private:
+    struct Bucket
+    {
+        std::unordered_map<uint64_t, beam::Amount> normal;
+        std::unordered_map<beam::TxoID, beam::Amount> shielded;
+
+        // running sums of the amounts sorted from the largest one,
+        // rebuilt on the first calculation after a change
+        mutable std::vector<beam::Amount> sums;
+        mutable bool dirty = true;
+    };
+
+    using Buckets = std::unordered_map<beam::Asset::ID, Bucket>;
+
+    // describe(coin, key, assetId, amount) fills the coin's fields and tells if it can be spent
+    template <typename Key, typename Coin, typename Describe>
+    void applyChanges(std::unordered_map<Key, beam::Amount> Bucket::*coinsOf,
+                      beam::wallet::ChangeAction action,
+                      const std::vector<Coin>& coins,
+                      Describe&& describe);
+
+    [[nodiscard]] const std::vector<beam::Amount>& sumsOf(beam::Asset::ID assetId) const;
+    [[nodiscard]] bool select(beam::Asset::ID assetId, beam::Amount target, beam::Amount& selected) const;
+    [[nodiscard]] beam::Amount total(beam::Asset::ID assetId) const;
+
+    Buckets _buckets;
+};
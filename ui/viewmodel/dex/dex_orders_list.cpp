@@ -10,8 +10,43 @@
 // limitations under the License.
 #include "dex_orders_list.h"
 
+namespace
+{
+    // TODO:DEX orders carry no price yet, rows and the book share this one
+    constexpr beam::Amount kOrderPrice = 10;
+    constexpr int kPriceDecimals = 2;
+}
+
 DexOrdersList::DexOrdersList()
+    : m_orderBook(kPriceDecimals)
+{
+}
+
+std::string DexOrdersList::keyOf(const beam::wallet::DexOrder& order) const
+{
+    return order.orderID.to_string();
+}
+
+const DexOrderBook& DexOrdersList::getOrderBook() const
+{
+    return m_orderBook;
+}
+
+void DexOrdersList::onItemAdded(const beam::wallet::DexOrder& order)
+{
+    // the maker who sells beam asks, the one who buys it bids
+    const bool isBid = order.sellCoin != 0;
+    m_orderBook.insert(keyOf(order), isBid, kOrderPrice, order.amount, order.amount * kOrderPrice);
+}
+
+void DexOrdersList::onItemRemoved(const beam::wallet::DexOrder& order)
+{
+    m_orderBook.remove(keyOf(order));
+}
+
+void DexOrdersList::onItemsCleared()
 {
+    m_orderBook.clear();
 }
 
 QHash<int, QByteArray> DexOrdersList::roleNames() const
@@ -48,11 +83,11 @@ QVariant DexOrdersList::data(const QModelIndex &index, int role) const
     case Roles::RType:
         return order.sellCoin == 0 ? "Sell BEAM" : "Buy BEAM";
     case Roles::RPrice:
-        return QString("10 BEAM-X");
+        return QString::number(kOrderPrice) + " BEAM-X";
     case Roles::RSize:
         return QString::number(order.amount) + " BEAM";
     case Roles::RTotal:
-        return QString::number(order.amount * 10) + " BEAM-X";
+        return QString::number(order.amount * kOrderPrice) + " BEAM-X";
     case Roles::RExpiration:
         return QString::fromStdString(order.orderID.to_string());
     case Roles::RStatus:
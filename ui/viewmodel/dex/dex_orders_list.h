@@ -13,9 +13,13 @@
 #include <memory>
 #include "dex_order_object.h"
 #include "viewmodel/helpers/list_model.h"
+#include "viewmodel/helpers/order_book.h"
 #include "wallet/client/extensions/dex_board/dex_order.h"
 
-class DexOrdersList : public ListModel<beam::wallet::DexOrder>
+// BEAM/BEAM-X orders, beam is the base of the pair
+using DexOrderBook = OrderBook<std::string>;
+
+class DexOrdersList : public KeyedListModel<beam::wallet::DexOrder, std::string>
 {
     Q_OBJECT
 public:
@@ -39,6 +43,16 @@ public:
     [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
     [[nodiscard]] QVariant data(const QModelIndex &index, int role) const override;
 
+    [[nodiscard]] const DexOrderBook& getOrderBook() const;
+
     // TODO:DEX refactor and hide
     beam::PeerID selfID;
+
+private:
+    [[nodiscard]] std::string keyOf(const beam::wallet::DexOrder& order) const override;
+    void onItemAdded(const beam::wallet::DexOrder& order) override;
+    void onItemRemoved(const beam::wallet::DexOrder& order) override;
+    void onItemsCleared() override;
+
+    DexOrderBook m_orderBook;
 };
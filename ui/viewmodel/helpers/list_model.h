@@ -15,8 +15,14 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <QAbstractListModel>
+#include <QHash>
 Q_DECLARE_METATYPE(QModelIndex)
 template <typename T>
 class ListModel : public QAbstractListModel
@@ -156,3 +162,490 @@ public:
 protected:
     QList<T> m_list;
 };
+
+// Hash for fixed-size byte containers (TxID & co) used as row keys
+struct BlobKeyHash
+{
+    template <typename B>
+    size_t operator()(const B& blob) const
+    {
+        return qHashBits(blob.data(), blob.size());
+    }
+};
+
+// List model which keeps key -> row index in sync with the list.
+// Lookups by key are O(1), updates are applied in place with dataChanged,
+// and inserts/removes are coalesced into contiguous row ranges.
+// It is not a ListModel, rows can't be changed past the key index
+template <typename T, typename Key, typename Hash = std::hash<Key>>
+class KeyedListModel : public QAbstractListModel
+{
+public:
+    KeyedListModel(QObject* pObj = nullptr)
+        : QAbstractListModel(pObj)
+    {
+    }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_list.size();
+    }
+
+    T get(int index) const
+    {
+        return m_list.at(index);
+    }
+
+    void insert(const T& item)
+    {
+        insert(std::vector<T>{item});
+    }
+
+    void insert(const std::vector<T>& items)
+    {
+        std::vector<T> toAppend;
+        std::vector<int> changed;
+        toAppend.reserve(items.size());
+
+        for (const auto& item : items)
+        {
+            auto it = m_index.find(keyOf(item));
+            if (it != m_index.end())
+            {
+                onItemRemoved(this->m_list[it->second]);
+                this->m_list[it->second] = item;
+                onItemAdded(item);
+                changed.push_back(it->second);
+            }
+            else
+            {
+                toAppend.push_back(item);
+            }
+        }
+
+        emitChanged(changed);
+        append(toAppend);
+    }
+
+    void update(const std::vector<T>& items)
+    {
+        // the same as insert, unknown items are appended
+        insert(items);
+    }
+
+    void remove(const std::vector<T>& items)
+    {
+        std::vector<int> rows;
+        rows.reserve(items.size());
+
+        for (const auto& item : items)
+        {
+            auto it = m_index.find(keyOf(item));
+            if (it != m_index.end())
+            {
+                rows.push_back(it->second);
+            }
+        }
+
+        removeRows(rows);
+    }
+
+    virtual void removeKeys(const std::vector<Key>& keys)
+    {
+        std::vector<int> rows;
+        rows.reserve(keys.size());
+
+        for (const auto& key : keys)
+        {
+            auto it = m_index.find(key);
+            if (it != m_index.end())
+            {
+                rows.push_back(it->second);
+            }
+        }
+
+        removeRows(rows);
+    }
+
+    // Removes all rows whose keys are not in the given set
+    template <typename KeySet>
+    void retain(const KeySet& keys)
+    {
+        std::vector<int> rows;
+        for (int row = 0; row < this->m_list.size(); ++row)
+        {
+            if (keys.find(keyOf(this->m_list[row])) == keys.end())
+            {
+                rows.push_back(row);
+            }
+        }
+
+        removeRows(rows);
+    }
+
+    void reset(const std::vector<T>& items)
+    {
+        this->beginResetModel();
+        this->m_list.clear();
+        this->m_list.reserve(int(items.size()));
+        m_index.clear();
+        m_index.reserve(items.size());
+        onItemsCleared();
+
+        for (const auto& item : items)
+        {
+            auto res = m_index.emplace(keyOf(item), this->m_list.size());
+            if (res.second)
+            {
+                this->m_list.push_back(item);
+            }
+            else
+            {
+                this->m_list[res.first->second] = item;
+            }
+        }
+        for (const auto& item : this->m_list)
+        {
+            onItemAdded(item);
+        }
+        this->endResetModel();
+    }
+
+    // Ordered variant of insert, the list must already be sorted by less.
+    // Items are placed with binary search, an updated item which still fits
+    // between its neighbours is changed in place. Big batches are applied
+    // in place and appended, then the whole list is reordered at once
+    template <typename Less>
+    void insertSorted(const std::vector<T>& items, const Less& less)
+    {
+        const size_t kMergeThreshold = 64;
+        if (items.size() > kMergeThreshold && items.size() * 4 > size_t(this->m_list.size()))
+        {
+            insert(items);
+            sort(less);
+            return;
+        }
+
+        for (const auto& item : items)
+        {
+            auto it = m_index.find(keyOf(item));
+            if (it != m_index.end())
+            {
+                std::vector<int> rows{it->second};
+                const int row = it->second;
+                const bool fits = (row == 0 || !less(item, this->m_list[row - 1])) &&
+                                  (row + 1 == this->m_list.size() || !less(this->m_list[row + 1], item));
+                if (fits)
+                {
+                    onItemRemoved(this->m_list[row]);
+                    this->m_list[row] = item;
+                    onItemAdded(item);
+                    emitChanged(rows);
+                    continue;
+                }
+                removeRows(rows);
+            }
+
+            const int row = int(std::upper_bound(this->m_list.begin(), this->m_list.end(), item, less) - this->m_list.begin());
+            this->beginInsertRows(QModelIndex(), row, row);
+            this->m_list.insert(row, item);
+            onItemAdded(item);
+            reindex(row);
+            this->endInsertRows();
+        }
+    }
+
+    // Rows are moved as one layout change, views keep their delegates
+    template <typename Less>
+    void sort(const Less& less)
+    {
+        std::vector<int> order(this->m_list.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this, &less](int left, int right)
+        {
+            return less(this->m_list[left], this->m_list[right]);
+        });
+        applyOrder(order);
+    }
+
+    int indexOf(const Key& key) const
+    {
+        auto it = m_index.find(key);
+        return it != m_index.end() ? it->second : -1;
+    }
+
+    bool contains(const Key& key) const
+    {
+        return m_index.find(key) != m_index.end();
+    }
+
+    // Emits one dataChanged per contiguous range of given rows
+    void touchRows(std::vector<int> rows, const QVector<int>& roles = QVector<int>())
+    {
+        emitChanged(rows, roles);
+    }
+
+    // Read only access, rows are changed through the mutators above
+    auto begin() const
+    {
+        return this->m_list.cbegin();
+    }
+
+    auto end() const
+    {
+        return this->m_list.cend();
+    }
+
+protected:
+    virtual Key keyOf(const T& item) const = 0;
+
+    // Hooks for secondary indexes kept by derived models,
+    // called whenever an item enters or leaves the list
+    virtual void onItemAdded(const T&) {}
+    virtual void onItemRemoved(const T&) {}
+    virtual void onItemsCleared() {}
+
+    template <typename Func>
+    static void forEachRange(const std::vector<int>& sortedRows, Func&& func, bool reverse = false)
+    {
+        if (sortedRows.empty())
+        {
+            return;
+        }
+
+        if (reverse)
+        {
+            int last = sortedRows.back();
+            int first = last;
+            for (auto it = sortedRows.rbegin() + 1; it != sortedRows.rend(); ++it)
+            {
+                if (*it + 1 != first)
+                {
+                    func(first, last);
+                    last = *it;
+                }
+                first = *it;
+            }
+            func(first, last);
+        }
+        else
+        {
+            int first = sortedRows.front();
+            int last = first;
+            for (auto it = sortedRows.begin() + 1; it != sortedRows.end(); ++it)
+            {
+                if (*it != last + 1)
+                {
+                    func(first, last);
+                    first = *it;
+                }
+                last = *it;
+            }
+            func(first, last);
+        }
+    }
+
+    void emitChanged(std::vector<int>& rows, const QVector<int>& roles = QVector<int>())
+    {
+        if (rows.empty())
+        {
+            return;
+        }
+
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        forEachRange(rows, [this, &roles](int first, int last)
+        {
+            emit this->dataChanged(this->createIndex(first, 0), this->createIndex(last, 0), roles);
+        });
+    }
+
+    void append(const std::vector<T>& items)
+    {
+        if (items.empty())
+        {
+            return;
+        }
+
+        const int first = this->m_list.size();
+        std::vector<T> unique;
+        unique.reserve(items.size());
+        for (const auto& item : items)
+        {
+            // duplicates inside one batch collapse into the latest value
+            auto res = m_index.emplace(keyOf(item), first + int(unique.size()));
+            if (res.second)
+            {
+                unique.push_back(item);
+            }
+            else
+            {
+                unique[res.first->second - first] = item;
+            }
+        }
+
+        this->beginInsertRows(QModelIndex(), first, first + int(unique.size()) - 1);
+        this->m_list.reserve(first + int(unique.size()));
+        for (const auto& item : unique)
+        {
+            this->m_list.push_back(item);
+            onItemAdded(item);
+        }
+        this->endInsertRows();
+    }
+
+    void removeRows(std::vector<int>& rows)
+    {
+        if (rows.empty())
+        {
+            return;
+        }
+
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        for (int row : rows)
+        {
+            m_index.erase(keyOf(this->m_list[row]));
+            onItemRemoved(this->m_list[row]);
+        }
+
+        // remove from the tail so earlier row numbers stay valid
+        forEachRange(rows, [this](int first, int last)
+        {
+            this->beginRemoveRows(QModelIndex(), first, last);
+            this->m_list.erase(this->m_list.begin() + first, this->m_list.begin() + last + 1);
+            this->endRemoveRows();
+        }, true);
+
+        reindex(rows.front());
+    }
+
+    // order[i] is the current row which goes to row i, the rows are the same
+    // before and after, persistent indexes follow the moved rows
+    void applyOrder(const std::vector<int>& order)
+    {
+        int row = 0;
+        while (row < int(order.size()) && order[row] == row)
+        {
+            ++row;
+        }
+        if (row == int(order.size()))
+        {
+            return;
+        }
+
+        emit this->layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+
+        std::vector<int> newRows(order.size());
+        QList<T> list;
+        list.reserve(int(order.size()));
+        for (row = 0; row < int(order.size()); ++row)
+        {
+            newRows[order[row]] = row;
+            list.push_back(this->m_list[order[row]]);
+        }
+        this->m_list.swap(list);
+        reindex(0);
+
+        const auto from = this->persistentIndexList();
+        QModelIndexList to;
+        to.reserve(from.size());
+        for (const auto& index : from)
+        {
+            to.push_back(this->createIndex(newRows[index.row()], index.column()));
+        }
+        this->changePersistentIndexList(from, to);
+
+        emit this->layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+    }
+
+    void reindex(int fromRow)
+    {
+        for (int row = fromRow; row < this->m_list.size(); ++row)
+        {
+            m_index[keyOf(this->m_list[row])] = row;
+        }
+    }
+
+    QList<T> m_list;
+    std::unordered_map<Key, int, Hash> m_index;
+};
+
+// Group -> keys index (asset id -> rows & co), derived models fill it from
+// the KeyedListModel hooks and map the keys back to rows with indexOf.
+// Groups of a key are remembered so removal doesn't need the item again
+template <typename Group, typename Key, typename KeyHash = std::hash<Key>>
+class KeyGroupIndex
+{
+public:
+    template <typename Groups>
+    void add(const Key& key, const Groups& groups)
+    {
+        remove(key);
+
+        auto& stored = m_groups[key];
+        for (const auto& group : groups)
+        {
+            if (m_keys[group].insert(key).second)
+            {
+                stored.push_back(group);
+            }
+        }
+
+        if (stored.empty())
+        {
+            m_groups.erase(key);
+        }
+    }
+
+    void remove(const Key& key)
+    {
+        auto it = m_groups.find(key);
+        if (it == m_groups.end())
+        {
+            return;
+        }
+
+        for (const auto& group : it->second)
+        {
+            auto keys = m_keys.find(group);
+            if (keys != m_keys.end())
+            {
+                keys->second.erase(key);
+                if (keys->second.empty())
+                {
+                    m_keys.erase(keys);
+                }
+            }
+        }
+        m_groups.erase(it);
+    }
+
+    void clear()
+    {
+        m_keys.clear();
+        m_groups.clear();
+    }
+
+    template <typename Groups, typename Func>
+    void forEachKey(const Groups& groups, Func&& func) const
+    {
+        for (const auto& group : groups)
+        {
+            auto it = m_keys.find(group);
+            if (it != m_keys.end())
+            {
+                for (const auto& key : it->second)
+                {
+                    func(key);
+                }
+            }
+        }
+    }
+
+private:
+    std::unordered_map<Group, std::unordered_set<Key, KeyHash>> m_keys;
+    std::unordered_map<Key, std::vector<Group>, KeyHash> m_groups;
+};
@@ -0,0 +1,176 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// One aggregated price level of an order book side
+struct OrderBookLevel
+{
+    bool     isBid = false;
+    int64_t  ticks = 0; // price in steps of the book
+    double   price = 0; // ticks * step
+    uint64_t size  = 0; // sum of base amounts
+    uint64_t total = 0; // sum of quote amounts
+    int      count = 0;
+
+    // bid and ask levels never share a key
+    uint64_t key() const
+    {
+        return (static_cast<uint64_t>(ticks) << 1) | (isBid ? 1 : 0);
+    }
+};
+
+// Price ladders of one trading pair. Orders are kept by key and prices are
+// rounded to the step of the book, orders within a step share a level.
+// Insert, remove and best price are O(log n), depth queries walk only
+// the levels they return
+template <typename Key, typename KeyHash = std::hash<Key>>
+class OrderBook
+{
+public:
+    explicit OrderBook(int priceDecimals)
+        : m_scale(std::pow(10.0, priceDecimals))
+    {
+    }
+
+    void insert(const Key& key, bool isBid, double price, uint64_t size, uint64_t total)
+    {
+        remove(key);
+
+        const auto ticks = static_cast<int64_t>(std::llround(price * m_scale));
+        auto& level = ladderOf(isBid)[ticks];
+        level.isBid = isBid;
+        level.ticks = ticks;
+        level.price = ticks / m_scale;
+        level.size += size;
+        level.total += total;
+        ++level.count;
+
+        m_orders.emplace(key, Order{isBid, ticks, size, total});
+        ++m_version;
+    }
+
+    bool remove(const Key& key)
+    {
+        auto it = m_orders.find(key);
+        if (it == m_orders.end())
+        {
+            return false;
+        }
+
+        const auto& order = it->second;
+        auto& ladder = ladderOf(order.isBid);
+        auto level = ladder.find(order.ticks);
+        if (level != ladder.end())
+        {
+            level->second.size -= order.size;
+            level->second.total -= order.total;
+            if (--level->second.count == 0)
+            {
+                ladder.erase(level);
+            }
+        }
+
+        m_orders.erase(it);
+        ++m_version;
+        return true;
+    }
+
+    void clear()
+    {
+        m_orders.clear();
+        m_bids.clear();
+        m_asks.clear();
+        ++m_version;
+    }
+
+    bool contains(const Key& key) const
+    {
+        return m_orders.find(key) != m_orders.end();
+    }
+
+    // highest bid or lowest ask
+    std::optional<double> bestPrice(bool isBid) const
+    {
+        if (isBid)
+        {
+            return m_bids.empty() ? std::optional<double>() : m_bids.rbegin()->second.price;
+        }
+        return m_asks.empty() ? std::optional<double>() : m_asks.begin()->second.price;
+    }
+
+    // levels from the best price outwards, all of them when maxLevels is 0
+    std::vector<OrderBookLevel> depth(bool isBid, size_t maxLevels = 0) const
+    {
+        std::vector<OrderBookLevel> levels;
+        auto collect = [&levels, maxLevels](auto begin, auto end)
+        {
+            for (auto it = begin; it != end && (maxLevels == 0 || levels.size() < maxLevels); ++it)
+            {
+                levels.push_back(it->second);
+            }
+        };
+
+        if (isBid)
+        {
+            collect(m_bids.rbegin(), m_bids.rend());
+        }
+        else
+        {
+            collect(m_asks.begin(), m_asks.end());
+        }
+        return levels;
+    }
+
+    size_t size() const
+    {
+        return m_orders.size();
+    }
+
+    // changes whenever the book does, lets views skip needless refreshes
+    uint64_t version() const
+    {
+        return m_version;
+    }
+
+private:
+    using Ladder = std::map<int64_t, OrderBookLevel>;
+
+    struct Order
+    {
+        bool     isBid;
+        int64_t  ticks;
+        uint64_t size;
+        uint64_t total;
+    };
+
+    Ladder& ladderOf(bool isBid)
+    {
+        return isBid ? m_bids : m_asks;
+    }
+
+    double   m_scale;
+    std::unordered_map<Key, Order, KeyHash> m_orders;
+    Ladder   m_bids;
+    Ladder   m_asks;
+    uint64_t m_version = 0;
+};
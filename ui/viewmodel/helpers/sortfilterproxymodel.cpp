@@ -13,6 +13,68 @@
 // limitations under the License.
 
 #include "sortfilterproxymodel.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    bool hasAnyOf(const QString& str, const char* chars)
+    {
+        for (const QChar c : str)
+        {
+            for (const char* p = chars; *p; ++p)
+            {
+                if (c == QLatin1Char(*p))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    bool containsId(const std::vector<qint64>& ids, qint64 id)
+    {
+        return std::binary_search(ids.begin(), ids.end(), id);
+    }
+
+    // role value may be a single id, a list of ids or a space separated string
+    bool containsAnyId(const std::vector<qint64>& ids, const QVariant& v)
+    {
+        if (v.type() == QVariant::String)
+        {
+            const QString str = v.toString();
+            qint64 id = 0;
+            bool inNumber = false;
+            for (const QChar c : str)
+            {
+                if (c.isDigit())
+                {
+                    id = id * 10 + c.digitValue();
+                    inNumber = true;
+                }
+                else if (inNumber)
+                {
+                    if (containsId(ids, id))
+                        return true;
+                    id = 0;
+                    inNumber = false;
+                }
+            }
+            return inNumber && containsId(ids, id);
+        }
+
+        if (v.type() == QVariant::List)
+        {
+            const auto list = v.toList();
+            return std::any_of(list.begin(), list.end(), [&ids](const QVariant& item) {
+                return containsId(ids, item.toLongLong());
+            });
+        }
+
+        bool ok = false;
+        const auto id = v.toLongLong(&ok);
+        return ok && containsId(ids, id);
+    }
+}
 
 SortFilterProxyModel::SortFilterProxyModel(QObject *parent) 
     : QSortFilterProxyModel(parent)
@@ -37,6 +99,46 @@ QObject *SortFilterProxyModel::source() const
 void SortFilterProxyModel::setSource(QObject *source)
 {
     setSourceModel(qobject_cast<QAbstractItemModel *>(source));
+    if (m_complete) {
+        resolveRoles();
+        applySortRole();
+        invalidateFilter();
+    }
+}
+
+void SortFilterProxyModel::setSourceModel(QAbstractItemModel *model)
+{
+    for (const auto& c : m_sourceConnections)
+        disconnect(c);
+    m_sourceConnections.clear();
+    m_rowKeys.clear();
+
+    // connected before the base class handlers, so keys are dropped
+    // before the rows get re-sorted or re-filtered
+    if (model) {
+        m_sourceConnections
+            << connect(model, &QAbstractItemModel::dataChanged, this,
+                [this](const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles) {
+                    invalidateRowKeys(topLeft.row(), bottomRight.row(), roles);
+                })
+            << connect(model, &QAbstractItemModel::rowsInserted, this,
+                [this](const QModelIndex &, int first, int last) {
+                    if (first < static_cast<int>(m_rowKeys.size()))
+                        m_rowKeys.insert(m_rowKeys.begin() + first, last - first + 1, RowKeys());
+                })
+            << connect(model, &QAbstractItemModel::rowsRemoved, this,
+                [this](const QModelIndex &, int first, int last) {
+                    const int size = static_cast<int>(m_rowKeys.size());
+                    if (first < size)
+                        m_rowKeys.erase(m_rowKeys.begin() + first, m_rowKeys.begin() + std::min(last + 1, size));
+                })
+            << connect(model, &QAbstractItemModel::rowsMoved, this, [this]() { invalidateRowKeys(); })
+            << connect(model, &QAbstractItemModel::layoutAboutToBeChanged, this, [this]() { invalidateRowKeys(); })
+            << connect(model, &QAbstractItemModel::layoutChanged, this, [this]() { invalidateRowKeys(); })
+            << connect(model, &QAbstractItemModel::modelReset, this, [this]() { invalidateRowKeys(); });
+    }
+
+    QSortFilterProxyModel::setSourceModel(model);
 }
 
 QByteArray SortFilterProxyModel::sortRole() const
@@ -49,7 +151,7 @@ void SortFilterProxyModel::setSortRole(const QByteArray &role)
     if (m_sortRole != role) {
         m_sortRole = role;
         if (m_complete)
-            QSortFilterProxyModel::setSortRole(roleKey(role));
+            applySortRole();
     }
 }
 
@@ -67,8 +169,10 @@ void SortFilterProxyModel::setFilterRole(const QByteArray &role)
 {
     if (m_filterRole != role) {
         m_filterRole = role;
-        if (m_complete)
-            QSortFilterProxyModel::setFilterRole(roleKey(role));
+        if (m_complete) {
+            m_filterRoleId = roleKey(role);
+            QSortFilterProxyModel::setFilterRole(m_filterRoleId);
+        }
     }
 }
 
@@ -79,7 +183,9 @@ QString SortFilterProxyModel::filterString() const
 
 void SortFilterProxyModel::setFilterString(const QString &filter)
 {
-    setFilterRegExp(QRegExp(filter, filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(filterSyntax())));
+    QRegExp rx(filter, filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(filterSyntax()));
+    compilePattern(rx);
+    setFilterRegExp(rx);
 }
 
 SortFilterProxyModel::FilterSyntax SortFilterProxyModel::filterSyntax() const
@@ -89,7 +195,52 @@ SortFilterProxyModel::FilterSyntax SortFilterProxyModel::filterSyntax() const
 
 void SortFilterProxyModel::setFilterSyntax(SortFilterProxyModel::FilterSyntax syntax)
 {
-    setFilterRegExp(QRegExp(filterString(), filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(syntax)));
+    QRegExp rx(filterString(), filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(syntax));
+    compilePattern(rx);
+    setFilterRegExp(rx);
+}
+
+Qt::CaseSensitivity SortFilterProxyModel::filterCaseSensitivity() const
+{
+    return QSortFilterProxyModel::filterCaseSensitivity();
+}
+
+void SortFilterProxyModel::setFilterCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    QRegExp rx = filterRegExp();
+    rx.setCaseSensitivity(cs);
+    compilePattern(rx);
+    QSortFilterProxyModel::setFilterCaseSensitivity(cs);
+}
+
+QVariantList SortFilterProxyModel::filters() const
+{
+    return m_filters;
+}
+
+void SortFilterProxyModel::setFilters(const QVariantList& filters)
+{
+    m_filters = filters;
+    if (m_complete) {
+        compilePredicates();
+        invalidateFilter();
+    }
+    emit filtersChanged();
+}
+
+SortFilterProxyModel::FilterMode SortFilterProxyModel::filterMode() const
+{
+    return m_filterMode;
+}
+
+void SortFilterProxyModel::setFilterMode(FilterMode mode)
+{
+    if (m_filterMode != mode) {
+        m_filterMode = mode;
+        if (m_complete)
+            invalidateFilter();
+        emit filtersChanged();
+    }
 }
 
 QVariantMap SortFilterProxyModel::get(int idx) const
@@ -109,16 +260,8 @@ QVariantMap SortFilterProxyModel::get(int idx) const
 
 QVariant SortFilterProxyModel::getRoleValue(int idx, QByteArray roleName) const
 {
-    QHash<int, QByteArray> roles = roleNames();
-    QHashIterator<int, QByteArray> it(roles);
-    while (it.hasNext()) {
-        it.next();
-        if (roleName == it.value())
-        {
-            return data(index(idx, 0), it.key());
-        }
-    }
-    return QVariant();
+    const int role = roleKey(roleName);
+    return role < 0 ? QVariant() : data(index(idx, 0), role);
 }
 
 void SortFilterProxyModel::classBegin()
@@ -128,14 +271,18 @@ void SortFilterProxyModel::classBegin()
 void SortFilterProxyModel::componentComplete()
 {
     m_complete = true;
-    if (!m_sortRole.isEmpty())
-        QSortFilterProxyModel::setSortRole(roleKey(m_sortRole));
+    resolveRoles();
+    applySortRole();
     if (!m_filterRole.isEmpty())
-        QSortFilterProxyModel::setFilterRole(roleKey(m_filterRole));
+        QSortFilterProxyModel::setFilterRole(m_filterRoleId);
+    invalidateFilter();
 }
 
 int SortFilterProxyModel::roleKey(const QByteArray &role) const
 {
+    if (!m_roleIds.isEmpty())
+        return m_roleIds.value(role, -1);
+
     QHash<int, QByteArray> roles = roleNames();
     QHashIterator<int, QByteArray> it(roles);
     while (it.hasNext()) {
@@ -146,6 +293,262 @@ int SortFilterProxyModel::roleKey(const QByteArray &role) const
     return -1;
 }
 
+void SortFilterProxyModel::applySortRole()
+{
+    if (m_sortRole.isEmpty())
+        return;
+
+    // the base class re-sorts right away
+    invalidateSortKeys();
+    QSortFilterProxyModel::setSortRole(roleKey(m_sortRole));
+}
+
+void SortFilterProxyModel::invalidateSortKeys()
+{
+    for (auto& keys : m_rowKeys)
+        keys.sort.type = SortKey::Type::None;
+}
+
+void SortFilterProxyModel::invalidateRowKeys()
+{
+    m_rowKeys.clear();
+}
+
+void SortFilterProxyModel::invalidateRowKeys(int first, int last, const QVector<int> &roles)
+{
+    const bool sortChanged = roles.isEmpty() || roles.contains(QSortFilterProxyModel::sortRole());
+
+    // slots of the folded roles named in the change
+    std::vector<size_t> folded;
+    for (size_t slot = 0; slot < m_foldedRoles.size(); ++slot) {
+        if (roles.isEmpty() || roles.contains(m_foldedRoles[slot]))
+            folded.push_back(slot);
+    }
+
+    const int size = static_cast<int>(m_rowKeys.size());
+    for (int row = std::max(first, 0); row <= last && row < size; ++row) {
+        auto& keys = m_rowKeys[row];
+        if (sortChanged)
+            keys.sort.type = SortKey::Type::None;
+        for (const auto slot : folded) {
+            if (slot < keys.folded.size())
+                keys.folded[slot].valid = false;
+        }
+    }
+}
+
+SortFilterProxyModel::RowKeys& SortFilterProxyModel::rowKeys(int row) const
+{
+    // grows to the whole source at once, so references to other rows stay valid
+    if (static_cast<size_t>(row) >= m_rowKeys.size())
+        m_rowKeys.resize(std::max(static_cast<size_t>(row) + 1, static_cast<size_t>(sourceModel()->rowCount())));
+    return m_rowKeys[row];
+}
+
+const QString& SortFilterProxyModel::foldedKey(const Predicate& p, const QModelIndex &sourceIndex) const
+{
+    auto& folded = rowKeys(sourceIndex.row()).folded;
+    if (folded.size() < m_foldedRoles.size())
+        folded.resize(m_foldedRoles.size());
+
+    auto& key = folded[p.slot];
+    if (!key.valid) {
+        key.text = sourceIndex.data(p.role).toString().toCaseFolded();
+        key.valid = true;
+    }
+    return key.text;
+}
+
+const SortFilterProxyModel::SortKey& SortFilterProxyModel::sortKey(const QModelIndex &sourceIndex) const
+{
+    auto& key = rowKeys(sourceIndex.row()).sort;
+    if (key.type != SortKey::Type::None)
+        return key;
+
+    const QVariant v = sourceIndex.data(QSortFilterProxyModel::sortRole());
+    switch (static_cast<QMetaType::Type>(v.type())) {
+    case QMetaType::Int:
+    case QMetaType::LongLong:
+    case QMetaType::Bool:
+        key.type = SortKey::Type::Signed;
+        key.i = v.toLongLong();
+        break;
+    case QMetaType::UInt:
+    case QMetaType::ULongLong:
+        key.type = SortKey::Type::Unsigned;
+        key.u = v.toULongLong();
+        break;
+    case QMetaType::Double:
+    case QMetaType::Float:
+        key.type = SortKey::Type::Real;
+        key.d = v.toDouble();
+        break;
+    case QMetaType::QString:
+        key.type = SortKey::Type::Text;
+        key.text = v.toString();
+        break;
+    default:
+        key.type = SortKey::Type::Other;
+        break;
+    }
+    return key;
+}
+
+void SortFilterProxyModel::resolveRoles()
+{
+    m_roleIds.clear();
+    m_allRoleIds.clear();
+
+    const auto roles = roleNames();
+    for (auto it = roles.cbegin(); it != roles.cend(); ++it) {
+        m_roleIds.insert(it.value(), it.key());
+        m_allRoleIds.push_back(it.key());
+    }
+
+    m_filterRoleId = m_filterRole.isEmpty() ? -1 : roleKey(m_filterRole);
+    compilePredicates();
+}
+
+void SortFilterProxyModel::compilePattern(const QRegExp& rx)
+{
+    const QString pattern = rx.pattern();
+
+    m_pattern = Pattern();
+    m_pattern.cs = rx.caseSensitivity();
+
+    if (pattern.isEmpty())
+        return;
+
+    switch (rx.patternSyntax()) {
+    case QRegExp::Wildcard:
+    case QRegExp::WildcardUnix:
+        if (std::all_of(pattern.begin(), pattern.end(), [](QChar c) { return c == QLatin1Char('*'); }))
+            return;
+        if (!hasAnyOf(pattern, "*?[]\\")) {
+            m_pattern.kind = Pattern::Kind::Substring;
+            m_pattern.needle = pattern;
+            return;
+        }
+        break;
+    case QRegExp::FixedString:
+        m_pattern.kind = Pattern::Kind::Substring;
+        m_pattern.needle = pattern;
+        return;
+    default:
+        if (!hasAnyOf(pattern, ".^$|()[]{}*+?\\")) {
+            m_pattern.kind = Pattern::Kind::Substring;
+            m_pattern.needle = pattern;
+            return;
+        }
+        break;
+    }
+
+    m_pattern.kind = Pattern::Kind::Regex;
+    m_pattern.rx = rx;
+}
+
+void SortFilterProxyModel::compilePredicates()
+{
+    const auto foldedRoles = m_foldedRoles;
+    m_predicates.clear();
+    m_predicates.reserve(m_filters.size());
+    m_foldedRoles.clear();
+
+    for (const auto& item : m_filters) {
+        const auto spec = item.toMap();
+        const auto type = spec.value("type", "equals").toString();
+
+        Predicate p;
+        p.role = roleKey(spec.value("role").toByteArray());
+        p.invert = spec.value("invert", false).toBool();
+
+        if (type == "range") {
+            p.kind = Predicate::Kind::Range;
+            p.min = spec.contains("min") ? spec.value("min").toDouble() : std::numeric_limits<double>::lowest();
+            p.max = spec.contains("max") ? spec.value("max").toDouble() : std::numeric_limits<double>::max();
+        } else if (type == "anyOf") {
+            p.kind = Predicate::Kind::AnyOf;
+            for (const auto& v : spec.value("values").toList())
+                p.values.push_back(v.toLongLong());
+            std::sort(p.values.begin(), p.values.end());
+        } else if (type == "contains") {
+            p.kind = Predicate::Kind::Contains;
+            p.needle = spec.value("value").toString().toCaseFolded();
+        } else {
+            p.kind = Predicate::Kind::Equals;
+            p.value = spec.value("value");
+        }
+
+        if (p.role < 0)
+            continue;
+
+        if (p.kind == Predicate::Kind::Contains) {
+            // one folded value per role, shared by all its predicates
+            const auto it = std::find(m_foldedRoles.begin(), m_foldedRoles.end(), p.role);
+            p.slot = static_cast<size_t>(it - m_foldedRoles.begin());
+            if (it == m_foldedRoles.end())
+                m_foldedRoles.push_back(p.role);
+        }
+
+        m_predicates.push_back(std::move(p));
+    }
+
+    // slots now mean other roles, drop what was folded for the old ones
+    if (foldedRoles != m_foldedRoles) {
+        for (auto& keys : m_rowKeys)
+            keys.folded.clear();
+    }
+}
+
+bool SortFilterProxyModel::acceptsPattern(const QModelIndex& sourceIndex) const
+{
+    if (m_pattern.kind == Pattern::Kind::AcceptAll)
+        return true;
+
+    const auto matches = [this](const QString& key) {
+        return m_pattern.kind == Pattern::Kind::Substring
+            ? key.contains(m_pattern.needle, m_pattern.cs)
+            : m_pattern.rx.indexIn(key) != -1;
+    };
+
+    if (m_filterRole.isEmpty()) {
+        return std::any_of(m_allRoleIds.begin(), m_allRoleIds.end(), [&](int role) {
+            return matches(sourceIndex.data(role).toString());
+        });
+    }
+    return matches(sourceIndex.data(m_filterRoleId).toString());
+}
+
+bool SortFilterProxyModel::accepts(const Predicate& p, const QModelIndex& sourceIndex) const
+{
+    if (p.kind == Predicate::Kind::Contains) {
+        // the needle is folded at compile time, the value once per row
+        return foldedKey(p, sourceIndex).contains(p.needle) != p.invert;
+    }
+
+    const QVariant v = sourceIndex.data(p.role);
+    bool res = false;
+
+    switch (p.kind) {
+    case Predicate::Kind::Equals:
+        res = v == p.value;
+        break;
+    case Predicate::Kind::Range: {
+        bool ok = false;
+        const double d = v.toDouble(&ok);
+        res = ok && d >= p.min && d <= p.max;
+        break;
+    }
+    case Predicate::Kind::AnyOf:
+        res = containsAnyId(p.values, v);
+        break;
+    case Predicate::Kind::Contains: // handled above
+        break;
+    }
+
+    return res != p.invert;
+}
+
 QHash<int, QByteArray> SortFilterProxyModel::roleNames() const
 {
     if (QAbstractItemModel *source = sourceModel())
@@ -153,27 +556,54 @@ QHash<int, QByteArray> SortFilterProxyModel::roleNames() const
     return QHash<int, QByteArray>();
 }
 
+bool SortFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+    // grow before taking references
+    rowKeys(std::max(left.row(), right.row()));
+
+    const SortKey& l = sortKey(left);
+    const SortKey& r = sortKey(right);
+
+    if (l.type != r.type || l.type == SortKey::Type::Other)
+        return QSortFilterProxyModel::lessThan(left, right);
+
+    switch (l.type) {
+    case SortKey::Type::Signed:
+        return l.i < r.i;
+    case SortKey::Type::Unsigned:
+        return l.u < r.u;
+    case SortKey::Type::Real:
+        return l.d < r.d;
+    default:
+        break;
+    }
+
+    return isSortLocaleAware()
+        ? l.text.localeAwareCompare(r.text) < 0
+        : l.text.compare(r.text, sortCaseSensitivity()) < 0;
+}
+
 bool SortFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
-    QRegExp rx = filterRegExp();
-    if (rx.isEmpty())
+    // roles are not resolved yet, componentComplete will refilter
+    if (!m_complete)
         return true;
-    QAbstractItemModel *model = sourceModel();
-    if (filterRole().isEmpty()) {
-        QHash<int, QByteArray> roles = roleNames();
-        QHashIterator<int, QByteArray> it(roles);
-        while (it.hasNext()) {
-            it.next();
-            QModelIndex sourceIndex = model->index(sourceRow, 0, sourceParent);
-            QString key = model->data(sourceIndex, it.key()).toString();
-            if (key.contains(rx))
-                return true;
-        }
-        return false;
-    }
-    QModelIndex sourceIndex = model->index(sourceRow, 0, sourceParent);
+
+    if (m_pattern.kind == Pattern::Kind::AcceptAll && m_predicates.empty())
+        return true;
+
+    QModelIndex sourceIndex = sourceModel()->index(sourceRow, 0, sourceParent);
     if (!sourceIndex.isValid())
         return true;
-    QString key = model->data(sourceIndex, roleKey(filterRole())).toString();
-    return key.contains(rx);
+
+    if (!acceptsPattern(sourceIndex))
+        return false;
+
+    if (m_predicates.empty())
+        return true;
+
+    const auto pred = [&](const Predicate& p) { return accepts(p, sourceIndex); };
+    return m_filterMode == AllOf
+        ? std::all_of(m_predicates.begin(), m_predicates.end(), pred)
+        : std::any_of(m_predicates.begin(), m_predicates.end(), pred);
 }
@@ -15,6 +15,7 @@
 
 #include <QtCore/qsortfilterproxymodel.h>
 #include <QtQml/qqmlparserstatus.h>
+#include <vector>
 
 class SortFilterProxyModel : public QSortFilterProxyModel, public QQmlParserStatus
 {
@@ -30,14 +31,27 @@ class SortFilterProxyModel : public QSortFilterProxyModel, public QQmlParserStat
     Q_PROPERTY(QByteArray filterRole READ filterRole WRITE setFilterRole)
     Q_PROPERTY(QString filterString READ filterString WRITE setFilterString)
     Q_PROPERTY(FilterSyntax filterSyntax READ filterSyntax WRITE setFilterSyntax)
+    Q_PROPERTY(Qt::CaseSensitivity filterCaseSensitivity READ filterCaseSensitivity WRITE setFilterCaseSensitivity)
+
+    // typed predicates, each is a map like
+    //   { role: "status", type: "equals", value: 3 }
+    //   { role: "amount", type: "range", min: 0, max: 100 }
+    //   { role: "assetFilter", type: "anyOf", values: [0, 5] }
+    //   { role: "search", type: "contains", value: "abc" }
+    // any of them accepts "invert: true". They are combined by filterMode
+    // and AND-ed with filterString
+    Q_PROPERTY(QVariantList filters READ filters WRITE setFilters NOTIFY filtersChanged)
+    Q_PROPERTY(FilterMode filterMode READ filterMode WRITE setFilterMode NOTIFY filtersChanged)
 
     Q_ENUMS(FilterSyntax)
+    Q_ENUMS(FilterMode)
 
 public:
     explicit SortFilterProxyModel(QObject *parent = 0);
 
     QObject *source() const;
     void setSource(QObject *source);
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
 
     QByteArray sortRole() const;
     void setSortRole(const QByteArray &role);
@@ -59,6 +73,20 @@ public:
     FilterSyntax filterSyntax() const;
     void setFilterSyntax(FilterSyntax syntax);
 
+    Qt::CaseSensitivity filterCaseSensitivity() const;
+    void setFilterCaseSensitivity(Qt::CaseSensitivity cs);
+
+    enum FilterMode {
+        AllOf,
+        AnyOf
+    };
+
+    QVariantList filters() const;
+    void setFilters(const QVariantList& filters);
+
+    FilterMode filterMode() const;
+    void setFilterMode(FilterMode mode);
+
     int count() const;
     Q_INVOKABLE QVariantMap get(int index) const;
     Q_INVOKABLE QVariant getRoleValue(int index, QByteArray roleName) const;
@@ -68,14 +96,116 @@ public:
 
 signals:
     void countChanged();
+    void filtersChanged();
 
 protected:
     int roleKey(const QByteArray &role) const;
     QHash<int, QByteArray> roleNames() const;
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
 
 private:
+    struct Pattern
+    {
+        enum class Kind
+        {
+            AcceptAll,
+            Substring,
+            Regex
+        };
+
+        Kind kind = Kind::AcceptAll;
+        QString needle;
+        Qt::CaseSensitivity cs = Qt::CaseSensitive;
+        mutable QRegExp rx;
+    };
+
+    struct Predicate
+    {
+        enum class Kind
+        {
+            Equals,
+            Range,
+            AnyOf,
+            Contains
+        };
+
+        Kind kind = Kind::Equals;
+        int role = -1;
+        bool invert = false;
+        QVariant value;
+        double min = 0;
+        double max = 0;
+        std::vector<qint64> values; // sorted
+        QString needle;             // case folded
+        size_t slot = 0;            // folded value in RowKeys, contains only
+    };
+
+    // sort role value of a source row, converted once
+    struct SortKey
+    {
+        enum class Type
+        {
+            None,
+            Signed,
+            Unsigned,
+            Real,
+            Text,
+            Other
+        };
+
+        Type type = Type::None;
+        union
+        {
+            qlonglong i;
+            qulonglong u;
+            double d;
+        };
+        QString text;
+    };
+
+    // case folded value of a role used by contains predicates
+    struct FoldedKey
+    {
+        bool valid = false;
+        QString text;
+    };
+
+    // keys of a source row, built on first use and dropped on dataChanged
+    struct RowKeys
+    {
+        SortKey sort;
+        std::vector<FoldedKey> folded; // by m_foldedRoles slot
+    };
+
+    RowKeys& rowKeys(int row) const;
+    const SortKey& sortKey(const QModelIndex &sourceIndex) const;
+    const QString& foldedKey(const Predicate& p, const QModelIndex &sourceIndex) const;
+    void applySortRole();
+    void invalidateSortKeys();
+    void invalidateRowKeys();
+    void invalidateRowKeys(int first, int last, const QVector<int> &roles);
+
+    void resolveRoles();
+    void compilePattern(const QRegExp& rx);
+    void compilePredicates();
+    bool acceptsPattern(const QModelIndex& sourceIndex) const;
+    bool accepts(const Predicate& p, const QModelIndex& sourceIndex) const;
+
     bool m_complete;
     QByteArray m_sortRole;
     QByteArray m_filterRole;
+
+    QHash<QByteArray, int> m_roleIds;
+    std::vector<int> m_allRoleIds;
+    int m_filterRoleId = -1;
+    Pattern m_pattern;
+
+    QVariantList m_filters;
+    FilterMode m_filterMode = AllOf;
+    std::vector<Predicate> m_predicates;
+    std::vector<int> m_foldedRoles;
+
+    mutable std::vector<RowKeys> m_rowKeys;
+    QList<QMetaObject::Connection> m_sourceConnections;
 };
@@ -20,14 +20,10 @@
 
 TokenBootstrapManager::TokenBootstrapManager()
     : _wallet_model(*AppModel::getInstance().getWalletModel())
+    , _txStore(AppModel::getInstance().getTransactions())
 {
-    connect(
-        &_wallet_model,
-        SIGNAL(transactionsChanged(beam::wallet::ChangeAction,
-                        const std::vector<beam::wallet::TxDescription>&)),
-        SLOT(onTransactionsChanged(beam::wallet::ChangeAction,
-                        const std::vector<beam::wallet::TxDescription>&)));
-    _wallet_model.getAsync()->getTransactions();
+    connect(_txStore.get(), &TransactionsStore::transactionsChanged, this, &TokenBootstrapManager::onTransactionsChanged);
+    _txStore->load();
 }
 
 TokenBootstrapManager::~TokenBootstrapManager() {}
@@ -36,31 +32,7 @@ void TokenBootstrapManager::onTransactionsChanged(
     beam::wallet::ChangeAction action,
     const std::vector<beam::wallet::TxDescription>& items)
 {
-    switch (action)
-    {
-    case beam::wallet::ChangeAction::Reset:
-        _myTxIds.clear(); // no break
-    case beam::wallet::ChangeAction::Added:
-    case beam::wallet::ChangeAction::Updated:
-        for (const auto& item : items)
-        {
-            if (const auto& id = item.GetTxID(); id)
-            {
-                _myTxIds.insert(*id);
-            }
-        }
-        break;
-    case beam::wallet::ChangeAction::Removed:
-        for (const auto& item : items)
-        {
-            if (const auto& id = item.GetTxID(); id)
-            {
-                _myTxIds.erase(*id);
-            }
-        }
-        break;
-    }
-
+    // the store is already updated, just check what is waiting
     checkIsTxPreviousAccepted();
 }
 
@@ -91,28 +63,25 @@ void TokenBootstrapManager::checkTokenForDuplicate(const QString& token)
     auto txIdValue = txId.value();
     _tokensInProgress[txIdValue] = token;
 
-    _myTxIds.empty()
-        ? _wallet_model.getAsync()->getTransactions()
-        : checkIsTxPreviousAccepted();
+    _txStore->isLoaded()
+        ? checkIsTxPreviousAccepted()
+        : _txStore->load();
 }
 
 void TokenBootstrapManager::checkIsTxPreviousAccepted()
 {
-    if (!_tokensInProgress.empty())
+    if (!_tokensInProgress.empty() && _txStore->isLoaded())
     {
-        for (const auto& txId : _myTxIds)
+        for (const auto& token : _tokensInProgress)
         {
-            const auto& it = _tokensInProgress.find(txId);
-            if (it != _tokensInProgress.end())
+            if (_txStore->find(token.first))
             {
-                emit tokenPreviousAccepted(it->second);
-                _tokensInProgress.erase(it);
+                emit tokenPreviousAccepted(token.second);
+            }
+            else
+            {
+                emit tokenFirstTimeAccepted(token.second);
             }
-        }
-
-        for (const auto& token : _tokensInProgress)
-        {
-            emit tokenFirstTimeAccepted(token.second);
         }
         _tokensInProgress.clear();
     }
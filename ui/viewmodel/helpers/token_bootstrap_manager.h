@@ -14,8 +14,8 @@
 #pragma once
 
 #include "model/wallet_model.h"
+#include "model/transactions_store.h"
 #include <map>
-#include <set>
 #include <QObject>
 
 class TokenBootstrapManager : public QObject
@@ -41,6 +41,6 @@ private:
     void checkIsTxPreviousAccepted();
 
     WalletModel& _wallet_model;
+    TransactionsStore::Ptr _txStore;
     std::map<beam::wallet::TxID, QString> _tokensInProgress;
-    std::set<beam::wallet::TxID> _myTxIds;
 };
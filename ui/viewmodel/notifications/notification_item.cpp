@@ -30,34 +30,11 @@ namespace {
         return token.UnpackParameters();
     }
 
-    QString getAmount(const beam::wallet::TxParameters &p)
-    {
-        return beamui::AmountToUIString(*p.GetParameter<Amount>(beam::wallet::TxParameterID::Amount));
-    }
-
-    QString getSwapAmount(const beam::wallet::TxParameters &p)
-    {
-        using namespace beam::wallet;
-
-        auto amount = *p.GetParameter<Amount>(TxParameterID::AtomicSwapAmount);
-        auto swapCoin = *p.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
-        return beamui::AmountToUIString(amount, beamui::convertSwapCoinToCurrency(swapCoin));
-    }
-
     bool isBeamSide(const beam::wallet::TxParameters &p)
     {
         return *p.GetParameter<bool>(beam::wallet::TxParameterID::AtomicSwapCoin);
     }
 
-    QString getSwapCoinName(const beam::wallet::TxParameters &p)
-    {
-        using namespace beam::wallet;
-
-        auto swapCoin = p.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
-        return beamui::toString(beamui::convertSwapCoinToCurrency(*swapCoin));
-    }
-
-
     bool getPeerID(const beam::wallet::TxParameters &p, beam::wallet::WalletID &result)
     {
         using namespace beam::wallet;
@@ -100,8 +77,7 @@ namespace {
             std::string str{rawMsg->cbegin(), rawMsg->cend()};
             return QString::fromStdString(str);
         }
-        //% "No description provided by the contract"
-        return qtTrId("notification-contract-no-message");
+        return QString();
     }
 
     bool isExpired(const beam::wallet::TxParameters& p)
@@ -123,18 +99,6 @@ namespace {
             && *failureReason == TxFailureReason::TransactionExpired;
     }
 
-    beam::wallet::WalletAddress getWalletAddressRaw(const beam::wallet::Notification& notification)
-    {
-        beam::wallet::WalletAddress walletAddress;
-        fromByteBuffer(notification.m_content, walletAddress);
-        return walletAddress;
-    }
-
-    QString getAddress(const beam::wallet::Notification& notification)
-    {
-        return beamui::toString(getWalletAddressRaw(notification).m_walletID);
-    }
-
     QString getTxCompletedMessage(const QString& amount, const QString& unitName, const QString& peer, bool isSender)
     {
         return (isSender ? 
@@ -161,6 +125,7 @@ namespace {
                 .arg(peer);
     }
 
+    // empty means the shielded pool, its name is translated on display
     QString getPushTxPeer(const beam::wallet::TxParameters& p, bool isSender)
     {
         if (isSender)
@@ -175,15 +140,103 @@ namespace {
         {
             return std::to_string(*peerID).c_str();
         }
-
-        //% "shielded pool"
-        return qtTrId("from-shielded-pool");
+        return QString();
     }
 }
 
 NotificationItem::NotificationItem(const beam::wallet::Notification& notification)
     : m_notification{notification}
-{}
+{
+    decode();
+}
+
+void NotificationItem::decode()
+{
+    using namespace beam::wallet;
+
+    switch(m_notification.m_type)
+    {
+        case Notification::Type::WalletImplUpdateAvailable:
+        {
+            WalletImplVerInfo info;
+            if (fromByteBuffer(m_notification.m_content, info))
+            {
+                m_content.version = QString::fromStdString(
+                    info.m_version.to_string() + "." + std::to_string(info.m_UIrevision));
+                m_content.valid = true;
+            }
+            else
+            {
+                LOG_ERROR() << "Software update notification deserialization error";
+            }
+            break;
+        }
+        case Notification::Type::AddressStatusChanged:
+            fromByteBuffer(m_notification.m_content, m_content.address);
+            m_content.valid = true;
+            break;
+        case Notification::Type::TransactionCompleted:
+        case Notification::Type::TransactionFailed:
+            try
+            {
+                decodeTx(getTxParameters(m_notification));
+                m_content.valid = true;
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR() << "Transaction notification deserialization error: " << e.what();
+            }
+            break;
+        default:
+            m_content.valid = true;
+            break;
+    }
+
+    m_type = typeImpl();
+}
+
+void NotificationItem::decodeTx(const beam::wallet::TxParameters& p)
+{
+    using namespace beam::wallet;
+
+    m_content.txType = getTxType(p);
+    m_content.assetId = getAssetId(p);
+    if (auto txID = p.GetTxID())
+    {
+        m_content.txID = QString::fromStdString(std::to_string(*txID));
+    }
+
+    switch (m_content.txType)
+    {
+    case TxType::Simple:
+    {
+        WalletID wid;
+        getPeerID(p, wid);
+        m_content.sender = isSender(p);
+        m_content.amount = *p.GetParameter<Amount>(TxParameterID::Amount);
+        m_content.peer = std::to_string(wid).c_str();
+        break;
+    }
+    case TxType::PushTransaction:
+        m_content.sender = isSender(p);
+        m_content.amount = *p.GetParameter<Amount>(TxParameterID::Amount);
+        m_content.peer = getPushTxPeer(p, m_content.sender);
+        break;
+    case TxType::AtomicSwap:
+        m_content.beamSide = isBeamSide(p);
+        m_content.amount = *p.GetParameter<Amount>(TxParameterID::Amount);
+        m_content.swapAmount = *p.GetParameter<Amount>(TxParameterID::AtomicSwapAmount);
+        m_content.swapCoin = *p.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
+        m_content.swapExpired = isSwapTxExpired(p);
+        break;
+    case TxType::Contract:
+        m_content.expired = isExpired(p);
+        m_content.contractMessage = getContractMessage(p);
+        break;
+    default:
+        break;
+    }
+}
 
 bool NotificationItem::operator==(const NotificationItem& other) const
 {
@@ -212,39 +265,45 @@ beam::wallet::Notification::State NotificationItem::getState() const
     return m_notification.m_state;
 }
 
+void NotificationItem::resetText() const
+{
+    m_title.reset();
+    m_message.reset();
+}
+
 QString NotificationItem::title() const
+{
+    if (!m_title)
+    {
+        m_title = titleImpl();
+    }
+    return *m_title;
+}
+
+QString NotificationItem::titleImpl() const
 {
     using namespace beam::wallet;
 
+    if (!m_content.valid)
+    {
+        return m_notification.m_type == Notification::Type::WalletImplUpdateAvailable ? QString() : "error";
+    }
+
     switch(m_notification.m_type)
     {
         case Notification::Type::WalletImplUpdateAvailable:
-        {
-            WalletImplVerInfo info;
-            if (fromByteBuffer(m_notification.m_content, info))
-            {
-                QString ver = QString::fromStdString(
-                    info.m_version.to_string() + "." + std::to_string(info.m_UIrevision));
-                //% "New version v %1 is available"
-                return qtTrId("notification-update-title").arg(ver);
-            }
-            else
-            {
-                LOG_ERROR() << "Software update notification deserialization error";
-                return QString();
-            }
-        }
+            //% "New version v %1 is available"
+            return qtTrId("notification-update-title").arg(m_content.version);
         case Notification::Type::AddressStatusChanged:
             //% "Address expired"
             return qtTrId("notification-address-expired");
         case Notification::Type::TransactionCompleted:
         {
-            auto p = getTxParameters(m_notification);
-            switch (getTxType(p))
+            switch (m_content.txType)
             {
             case TxType::Simple:
             case TxType::PushTransaction:
-                if (isSender(p))
+                if (m_content.sender)
                 {
                     //% "Transaction was sent"
                     return qtTrId("notification-transaction-sent");
@@ -263,22 +322,21 @@ QString NotificationItem::title() const
         }            
         case Notification::Type::TransactionFailed:
         {
-            auto p = getTxParameters(m_notification);
-            switch (getTxType(p))
+            switch (m_content.txType)
             {
             case TxType::Simple:
             case TxType::PushTransaction:
                 //% "Transaction failed"
                 return qtTrId("notification-transaction-failed");
             case TxType::AtomicSwap:
-                return isSwapTxExpired(p) ?
+                return m_content.swapExpired ?
                         //% "Atomic Swap offer expired"
                         qtTrId("notification-swap-expired")
                         :
                         //% "Atomic Swap offer failed"
                         qtTrId("notification-swap-failed");
             case TxType::Contract:
-                return isExpired(p) ?
+                return m_content.expired ?
                     //% "Contract transaction expired"
                     qtTrId("notification-contract-expired") :
                     //% "Contract transaction failed"
@@ -296,62 +354,74 @@ QString NotificationItem::title() const
 }
 
 QString NotificationItem::message(AssetsManager::Ptr amgr) const
+{
+    if (!m_message)
+    {
+        m_message = messageImpl(amgr);
+    }
+    return *m_message;
+}
+
+QString NotificationItem::messageImpl(const AssetsManager::Ptr& amgr) const
 {
     using namespace beam::wallet;
 
+    if (!m_content.valid)
+    {
+        return m_notification.m_type == Notification::Type::WalletImplUpdateAvailable ? QString() : "error";
+    }
+
+    const auto amount = [this]() { return beamui::AmountToUIString(m_content.amount); };
+    const auto swapAmount = [this]()
+    {
+        return beamui::AmountToUIString(m_content.swapAmount, beamui::convertSwapCoinToCurrency(m_content.swapCoin));
+    };
+    const auto swapCoinName = [this]() { return beamui::toString(beamui::convertSwapCoinToCurrency(m_content.swapCoin)); };
+    const auto pushPeer = [this]()
+    {
+        //% "shielded pool"
+        return m_content.peer.isEmpty() ? qtTrId("from-shielded-pool") : m_content.peer;
+    };
+    const auto contractMessage = [this]()
+    {
+        //% "No description provided by the contract"
+        return m_content.contractMessage.isEmpty() ? qtTrId("notification-contract-no-message") : m_content.contractMessage;
+    };
+
     switch(m_notification.m_type)
     {
         case Notification::Type::WalletImplUpdateAvailable:
         {
-            WalletImplVerInfo info;
-            if (fromByteBuffer(m_notification.m_content, info))
-            {
-                QString currentVer = QString::fromStdString(
-                    beamui::getCurrentLibVersion().to_string() + "." + std::to_string(beamui::getCurrentUIRevision()));
-                QString message("Your current version is v ");
-                message.append(currentVer);
-                message.append(". Please update to get the most of your Beam wallet.");
-                return message;
-            }
-            else
-            {
-                LOG_ERROR() << "Software update notification deserialization error";
-                return QString();
-            }
+            QString currentVer = QString::fromStdString(
+                beamui::getCurrentLibVersion().to_string() + "." + std::to_string(beamui::getCurrentUIRevision()));
+            QString message("Your current version is v ");
+            message.append(currentVer);
+            message.append(". Please update to get the most of your Beam wallet.");
+            return message;
         }
         case Notification::Type::AddressStatusChanged:
         {
-            QString address = getAddress(m_notification);
+            QString address = beamui::toString(m_content.address.m_walletID);
             //% "<b>%1</b> address expired."
             return qtTrId("notification-address-expired-message").arg(address);
         }
         case Notification::Type::TransactionCompleted:
         {
-            auto p = getTxParameters(m_notification);
-
-            switch (getTxType(p))
+            switch (m_content.txType)
             {
             case TxType::Simple:
             {
-                WalletID wid;
-                getPeerID(p, wid);
-
-                auto aid = getAssetId(p);
-                auto unitName = amgr->getUnitName(aid, AssetsManager::ShortenHtml);
-
-                return getTxCompletedMessage(getAmount(p), unitName, std::to_string(wid).c_str(), isSender(p));
+                auto unitName = amgr->getUnitName(m_content.assetId, AssetsManager::ShortenHtml);
+                return getTxCompletedMessage(amount(), unitName, m_content.peer, m_content.sender);
             }
             case TxType::PushTransaction:
             {
-                bool sender = isSender(p);
-                auto aid = getAssetId(p);
-                auto unitName = amgr->getUnitName(aid, AssetsManager::ShortenHtml);
-
-                return getTxCompletedMessage(getAmount(p), unitName, getPushTxPeer(p, sender), sender);
+                auto unitName = amgr->getUnitName(m_content.assetId, AssetsManager::ShortenHtml);
+                return getTxCompletedMessage(amount(), unitName, pushPeer(), m_content.sender);
             }
             case TxType::AtomicSwap:
             {
-                QString message = (isBeamSide(p) ?
+                QString message = (m_content.beamSide ?
                     //% "Offer <b>%1 BEAM ➞ %2 %3</b> with transaction ID <b>%4</b> completed."
                     qtTrId("notification-swap-beam-completed-message")
                     :
@@ -359,46 +429,37 @@ QString NotificationItem::message(AssetsManager::Ptr amgr) const
                     qtTrId("notification-swap-completed-message")
                     );
                 
-                return message.arg(getAmount(p))
-                              .arg(getSwapAmount(p))
-                              .arg(getSwapCoinName(p))
-                              .arg(std::to_string(*p.GetTxID()).c_str());
+                return message.arg(amount())
+                              .arg(swapAmount())
+                              .arg(swapCoinName())
+                              .arg(m_content.txID);
             }
             case TxType::Contract:
-                return getContractMessage(p);
+                return contractMessage();
             default:
                 return "error";
             }
         }
         case Notification::Type::TransactionFailed:
         {
-            auto p = getTxParameters(m_notification);
-            switch (getTxType(p))
+            switch (m_content.txType)
             {
             case TxType::Simple:
             {
-                WalletID wid;
-                getPeerID(p, wid);
-
-                auto aid = getAssetId(p);
-                auto unitName = amgr->getUnitName(aid, AssetsManager::ShortenHtml);
-
-                return getTxFailedMessage(getAmount(p), unitName, std::to_string(wid).c_str(), isSender(p));
+                auto unitName = amgr->getUnitName(m_content.assetId, AssetsManager::ShortenHtml);
+                return getTxFailedMessage(amount(), unitName, m_content.peer, m_content.sender);
             }
             case TxType::PushTransaction:
             {
-                bool sender = isSender(p);
-                auto aid = getAssetId(p);
-                auto unitName = amgr->getUnitName(aid, AssetsManager::ShortenHtml);
-
-                return getTxFailedMessage(getAmount(p), unitName, getPushTxPeer(p, sender), sender);
+                auto unitName = amgr->getUnitName(m_content.assetId, AssetsManager::ShortenHtml);
+                return getTxFailedMessage(amount(), unitName, pushPeer(), m_content.sender);
             }
             case TxType::AtomicSwap:
             {
                 QString message;
-                if (isSwapTxExpired(p))
+                if (m_content.swapExpired)
                 {
-                    message = isBeamSide(p) ?
+                    message = m_content.beamSide ?
                         //% "Offer <b>%1 BEAM ➞ %2 %3</b> with transaction ID <b>%4</b> expired."
                         qtTrId("notification-swap-beam-expired-message") :
                         //% "Offer <b>%1 %3 ➞ %2 BEAM</b> with transaction ID <b>%4</b> expired."
@@ -406,20 +467,20 @@ QString NotificationItem::message(AssetsManager::Ptr amgr) const
                 }
                 else
                 {
-                    message = isBeamSide(p) ?
+                    message = m_content.beamSide ?
                         //% "Offer <b>%1 BEAM ➞ %2 %3</b> with transaction ID <b>%4</b> failed."
                         qtTrId("notification-swap-beam-failed-message") :
                         //% "Offer <b>%1 %3 ➞ %2 BEAM</b> with transaction ID <b>%4</b> failed."
                         qtTrId("notification-swap-failed-message");
                 }
 
-                return message.arg(getAmount(p))
-                    .arg(getSwapAmount(p))
-                    .arg(getSwapCoinName(p))
-                    .arg(std::to_string(*p.GetTxID()).c_str());
+                return message.arg(amount())
+                    .arg(swapAmount())
+                    .arg(swapCoinName())
+                    .arg(m_content.txID);
             }
             case TxType::Contract:
-                return getContractMessage(p);
+                return contractMessage();
             default:
                 return "error";
             }
@@ -432,6 +493,11 @@ QString NotificationItem::message(AssetsManager::Ptr amgr) const
 }
 
 QString NotificationItem::type() const
+{
+    return m_type;
+}
+
+QString NotificationItem::typeImpl() const
 {
     using namespace beam::wallet;
     // !TODO: full list of the supported item types is: update expired received sent failed inpress hotnews videos events newsletter community
@@ -442,18 +508,18 @@ QString NotificationItem::type() const
         case Notification::Type::WalletImplUpdateAvailable:
             return "update";
         case Notification::Type::AddressStatusChanged:
-        {
-            const auto address = getWalletAddressRaw(m_notification);
-            return address.isExpired() ? "expired" : "extended";
-        }
+            return m_content.address.isExpired() ? "expired" : "extended";
         case Notification::Type::TransactionCompleted:
         {
-            auto p = getTxParameters(m_notification);
-            switch (getTxType(p))
+            if (!m_content.valid)
+            {
+                return "error";
+            }
+            switch (m_content.txType)
             {
             case TxType::Simple:
             case TxType::PushTransaction:
-                return (isSender(p) ? "sent" : "received");
+                return (m_content.sender ? "sent" : "received");
             case TxType::AtomicSwap:
                 return "swapCompleted";
             case TxType::Contract:
@@ -464,17 +530,20 @@ QString NotificationItem::type() const
         }
         case Notification::Type::TransactionFailed:
         {
-            auto p = getTxParameters(m_notification);
-            switch (getTxType(p))
+            if (!m_content.valid)
+            {
+                return "error";
+            }
+            switch (m_content.txType)
             {
             case TxType::Simple:
-                return (isSender(p) ? "failedToSend" : "failedToReceive");
+                return (m_content.sender ? "failedToSend" : "failedToReceive");
             case TxType::PushTransaction:
                 return "failedToSend";
             case TxType::AtomicSwap:
-                return isSwapTxExpired(p) ? "swapExpired" : "swapFailed";
+                return m_content.swapExpired ? "swapExpired" : "swapFailed";
             case TxType::Contract:
-                return isExpired(p) ? "contractExpired" : "contractFailed";
+                return m_content.expired ? "contractExpired" : "contractFailed";
             default:
                 return "error";
             }
@@ -505,23 +574,15 @@ QString NotificationItem::state() const
 
 QString NotificationItem::getTxID() const
 {
-    try
-    {
-        auto p = getTxParameters(m_notification);
-        return QString::fromStdString(std::to_string(*p.GetTxID()));
-    }
-    catch(...)
-    { }
-    return "";
+    return m_content.txID;
 }
 
 beam::wallet::WalletAddress NotificationItem::getWalletAddress() const
 {
-    return getWalletAddressRaw(m_notification);
+    return m_content.address;
 }
 
 beam::Asset::ID NotificationItem::assetId() const
 {
-    auto p = getTxParameters(m_notification);
-    return getAssetId(p);
+    return m_content.assetId;
 }
@@ -16,6 +16,7 @@
 
 #include <QObject>
 #include <QDateTime>
+#include <optional>
 #include "model/wallet_model.h"
 #include "viewmodel/ui_helpers.h"
 #include "viewmodel/wallet/assets_manager.h"
@@ -42,9 +43,48 @@ public:
 
     QString getTxID() const;
     beam::wallet::WalletAddress getWalletAddress() const;
+
+    // title and message are memoized, drop them when locale or asset info changes
+    void resetText() const;
  
 signals:
 
 private:
+    // notification content decoded once at construction
+    struct Content
+    {
+        bool valid = false;
+
+        // transaction notifications
+        beam::wallet::TxType txType = beam::wallet::TxType::Simple;
+        bool sender = false;
+        bool beamSide = false;
+        bool expired = false;
+        bool swapExpired = false;
+        beam::Asset::ID assetId = beam::Asset::s_BeamID;
+        beam::Amount amount = 0;
+        beam::Amount swapAmount = 0;
+        beam::wallet::AtomicSwapCoin swapCoin = beam::wallet::AtomicSwapCoin::Unknown;
+        QString peer; // empty for the shielded pool
+        QString txID;
+        QString contractMessage;
+
+        // address notifications
+        beam::wallet::WalletAddress address;
+
+        // update notifications
+        QString version;
+    };
+
+    void decode();
+    void decodeTx(const beam::wallet::TxParameters& p);
+    QString titleImpl() const;
+    QString messageImpl(const AssetsManager::Ptr& amgr) const;
+    QString typeImpl() const;
+
     beam::wallet::Notification m_notification;
+    Content m_content;
+    QString m_type;
+    mutable std::optional<QString> m_title;
+    mutable std::optional<QString> m_message;
 };
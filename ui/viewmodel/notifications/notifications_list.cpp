@@ -13,12 +13,14 @@
 // limitations under the License.
 
 #include "notifications_list.h"
+#include <array>
 #include "model/app_model.h"
 
 NotificationsList::NotificationsList()
 {
     _amgr = AppModel::getInstance().getAssets();
-    connect(_amgr.get(), &AssetsManager::assetInfo, this, &NotificationsList::onAssetInfo);
+    connect(_amgr.get(), &AssetsManager::assetsInfoChanged, this, &NotificationsList::onAssetsInfo);
+    connect(&AppModel::getInstance().getSettings(), &WalletSettings::localeChanged, this, &NotificationsList::onLocaleChanged);
 }
 
 QHash<int, QByteArray> NotificationsList::roleNames() const
@@ -81,12 +83,49 @@ QVariant NotificationsList::data(const QModelIndex &index, int role) const
     }
 }
 
-void NotificationsList::onAssetInfo(beam::Asset::ID assetId)
+ECC::uintBig NotificationsList::keyOf(const std::shared_ptr<NotificationItem>& item) const
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->assetId() == assetId) {
-           const auto idx = it - m_list.begin();
-           ListModel::touch(idx);
+    return item->getID();
+}
+
+void NotificationsList::onItemAdded(const std::shared_ptr<NotificationItem>& item)
+{
+    _assetIndex.add(item->getID(), std::array<beam::Asset::ID, 1>{item->assetId()});
+}
+
+void NotificationsList::onItemRemoved(const std::shared_ptr<NotificationItem>& item)
+{
+    _assetIndex.remove(item->getID());
+}
+
+void NotificationsList::onItemsCleared()
+{
+    _assetIndex.clear();
+}
+
+void NotificationsList::onAssetsInfo(const QSet<beam::Asset::ID>& assets)
+{
+    std::vector<int> rows;
+    _assetIndex.forEachKey(assets, [this, &rows](const ECC::uintBig& id) {
+        const auto row = indexOf(id);
+        if (row >= 0) {
+           rows.push_back(row);
+           m_list[row]->resetText();
         }
+    });
+    touchRows(std::move(rows), {static_cast<int>(Roles::Message)});
+}
+
+void NotificationsList::onLocaleChanged()
+{
+    if (m_list.isEmpty())
+    {
+        return;
+    }
+
+    for (const auto& item : m_list)
+    {
+        item->resetText();
     }
+    emit dataChanged(index(0), index(m_list.size() - 1), {static_cast<int>(Roles::Title), static_cast<int>(Roles::Message)});
 }
@@ -19,7 +19,15 @@
 #include "viewmodel/wallet/assets_manager.h"
 #include <QLocale>
 
-class NotificationsList : public ListModel<std::shared_ptr<NotificationItem>>
+struct NotificationIDHash
+{
+    size_t operator()(const ECC::uintBig& id) const
+    {
+        return qHashBits(id.m_pData, id.nBytes);
+    }
+};
+
+class NotificationsList : public KeyedListModel<std::shared_ptr<NotificationItem>, ECC::uintBig, NotificationIDHash>
 {
     Q_OBJECT
 
@@ -42,8 +50,14 @@ public:
     QHash<int, QByteArray> roleNames() const override;
 
 private:
-    void onAssetInfo(beam::Asset::ID assetId);
+    ECC::uintBig keyOf(const std::shared_ptr<NotificationItem>& item) const override;
+    void onItemAdded(const std::shared_ptr<NotificationItem>& item) override;
+    void onItemRemoved(const std::shared_ptr<NotificationItem>& item) override;
+    void onItemsCleared() override;
+    void onAssetsInfo(const QSet<beam::Asset::ID>& assets);
+    void onLocaleChanged();
 
     QLocale m_locale; // default locale
     AssetsManager::Ptr _amgr;
+    KeyGroupIndex<beam::Asset::ID, ECC::uintBig, NotificationIDHash> _assetIndex;
 };
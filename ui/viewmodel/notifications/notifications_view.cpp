@@ -17,6 +17,12 @@
 #include "utility/logger.h"
 #include "wallet/client/extensions/news_channels/interface.h"
 
+namespace
+{
+    // wallet reports bulk operations item by item, they are applied together
+    const int kChangesCoalesceDelay = 50;
+}
+
 NotificationsViewModel::NotificationsViewModel()
     : m_walletModel{*AppModel::getInstance().getWalletModel()}
 {
@@ -24,6 +30,10 @@ NotificationsViewModel::NotificationsViewModel()
             SIGNAL(notificationsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::Notification>&)),
             SLOT(onNotificationsDataModelChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::Notification>&)));
 
+    connect(&m_changesTimer, &QTimer::timeout, this, &NotificationsViewModel::applyChanges);
+    m_changesTimer.setSingleShot(true);
+    m_changesTimer.setInterval(kChangesCoalesceDelay);
+
     m_walletModel.getAsync()->getNotifications();
 }
 
@@ -32,11 +42,65 @@ QAbstractItemModel* NotificationsViewModel::getNotifications()
     return &m_notificationsList;
 }
 
+template <typename Pred>
+void NotificationsViewModel::removeIf(Pred&& pred)
+{
+    std::vector<ECC::uintBig> ids;
+    for (const auto& n : m_notificationsList)
+    {
+        if (pred(*n))
+        {
+            ids.push_back(n->getID());
+        }
+    }
+
+    if (ids.empty())
+    {
+        return;
+    }
+
+    // the list changes at once, echoes of the removals find nothing to remove.
+    // The notification center is private to the wallet client and the async
+    // interface deletes by id only, so a bulk delete is still one call per item
+    m_notificationsList.removeKeys(ids);
+
+    auto async = m_walletModel.getAsync();
+    for (const auto& id : ids)
+    {
+        async->deleteNotification(id);
+    }
+
+    emit allNotificationsChanged();
+}
+
 void NotificationsViewModel::clearAll()
 {
-    for(auto& n : m_notificationsList)
+    removeIf([](const NotificationItem&) { return true; });
+}
+
+void NotificationsViewModel::removeByType(const QString& type)
+{
+    removeIf([&type](const NotificationItem& n) { return n.type() == type; });
+}
+
+void NotificationsViewModel::removeOlderThan(int days)
+{
+    const auto now = beam::getTimestamp();
+    const beam::Timestamp age = static_cast<beam::Timestamp>(std::max(days, 0)) * 24 * 60 * 60;
+    const beam::Timestamp threshold = now > age ? now - age : 0;
+    removeIf([threshold](const NotificationItem& n) { return n.getTimestamp() < threshold; });
+}
+
+void NotificationsViewModel::markAllAsRead()
+{
+    // updates come back as one coalesced change
+    auto async = m_walletModel.getAsync();
+    for (const auto& n : m_notificationsList)
     {
-        m_walletModel.getAsync()->deleteNotification(n->getID());
+        if (n->getState() == beam::wallet::Notification::State::Unread)
+        {
+            async->markNotificationAsRead(n->getID());
+        }
     }
 }
 
@@ -79,62 +143,103 @@ void NotificationsViewModel::onNotificationsDataModelChanged(beam::wallet::Chang
 {
     using namespace beam::wallet;
 
-    std::vector<std::shared_ptr<NotificationItem>> modifiedNotifications;
-    modifiedNotifications.reserve(notifications.size());
+    if (action == ChangeAction::Reset)
+    {
+        m_changes.clear();
+    }
+
+    // consecutive changes of the same kind are merged into one
+    if (m_changes.empty() || m_changes.back().action != action || action == ChangeAction::Reset)
+    {
+        m_changes.push_back(Change{action, {}});
+    }
+    auto& pending = m_changes.back().notifications;
+    pending.insert(pending.end(), notifications.begin(), notifications.end());
+
+    if (!m_changesTimer.isActive())
+    {
+        m_changesTimer.start();
+    }
+}
+
+void NotificationsViewModel::applyChanges()
+{
+    using namespace beam::wallet;
+
+    auto changes = std::move(m_changes);
+    m_changes.clear();
 
-    for (const auto& n : notifications)
+    bool changed = false;
+    for (const auto& change : changes)
     {
-        if (action == ChangeAction::Removed || n.m_state != Notification::State::Deleted)
+        const auto action = change.action;
+
+        std::vector<std::shared_ptr<NotificationItem>> modifiedNotifications;
+        modifiedNotifications.reserve(change.notifications.size());
+
+        for (const auto& n : change.notifications)
         {
-            if (n.m_type == Notification::Type::WalletImplUpdateAvailable)
+            if (action == ChangeAction::Removed || n.m_state != Notification::State::Deleted)
             {
-                WalletImplVerInfo walletVersionInfo;
-                if (!fromByteBuffer(n.m_content, walletVersionInfo)) continue; 
-                if (walletVersionInfo.m_application != VersionInfo::Application::DesktopWallet) continue;
-
-                auto currentLibVersion = beamui::getCurrentLibVersion();
-                if (walletVersionInfo.m_version < currentLibVersion ||
-                    (walletVersionInfo.m_version == currentLibVersion &&
-                     walletVersionInfo.m_UIrevision <= beamui::getCurrentUIRevision()))
+                if (n.m_type == Notification::Type::WalletImplUpdateAvailable)
                 {
-                    continue;
+                    WalletImplVerInfo walletVersionInfo;
+                    if (!fromByteBuffer(n.m_content, walletVersionInfo)) continue; 
+                    if (walletVersionInfo.m_application != VersionInfo::Application::DesktopWallet) continue;
+
+                    auto currentLibVersion = beamui::getCurrentLibVersion();
+                    if (walletVersionInfo.m_version < currentLibVersion ||
+                        (walletVersionInfo.m_version == currentLibVersion &&
+                         walletVersionInfo.m_UIrevision <= beamui::getCurrentUIRevision()))
+                    {
+                        continue;
+                    }
                 }
+
+                modifiedNotifications.push_back(std::make_shared<NotificationItem>(n));
             }
+        }
 
-            modifiedNotifications.push_back(std::make_shared<NotificationItem>(n));
+        if (modifiedNotifications.empty() && action != ChangeAction::Reset)
+        {
+            continue;
         }
-    }
 
-    switch (action)
-    {
-        case ChangeAction::Reset:
-            {
-                m_notificationsList.reset(modifiedNotifications);
-                break;
-            }
+        switch (action)
+        {
+            case ChangeAction::Reset:
+                {
+                    m_notificationsList.reset(modifiedNotifications);
+                    break;
+                }
 
-        case ChangeAction::Added:
-            {
-                m_notificationsList.insert(modifiedNotifications);
-                break;
-            }
+            case ChangeAction::Added:
+                {
+                    m_notificationsList.insert(modifiedNotifications);
+                    break;
+                }
 
-        case ChangeAction::Removed:
-            {
-                m_notificationsList.remove(modifiedNotifications);
-                break;
-            }
+            case ChangeAction::Removed:
+                {
+                    m_notificationsList.remove(modifiedNotifications);
+                    break;
+                }
 
-        case ChangeAction::Updated:
-            {
-                m_notificationsList.update(modifiedNotifications);
+            case ChangeAction::Updated:
+                {
+                    m_notificationsList.update(modifiedNotifications);
+                    break;
+                }
+            
+            default:
+                assert(false && "Unexpected action");
                 break;
-            }
-        
-        default:
-            assert(false && "Unexpected action");
-            break;
+        }
+        changed = true;
+    }
+
+    if (changed)
+    {
+        emit allNotificationsChanged();
     }
-    
-    emit allNotificationsChanged();
 }
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <QObject>
+#include <QTimer>
 
 #include "model/app_model.h"
 #include "viewmodel/notifications/notifications_list.h"
@@ -29,7 +30,11 @@ public:
 
     QAbstractItemModel* getNotifications();
 
+    // bulk operations change the list at once, the wallet is updated item by item
     Q_INVOKABLE void clearAll();
+    Q_INVOKABLE void markAllAsRead();
+    Q_INVOKABLE void removeByType(const QString& type);
+    Q_INVOKABLE void removeOlderThan(int days);
     Q_INVOKABLE void removeItem(const ECC::uintBig& id);
     Q_INVOKABLE void markItemAsRead(const ECC::uintBig& id);
     Q_INVOKABLE QString getItemTxID(const ECC::uintBig& id);
@@ -42,8 +47,19 @@ signals:
     void allNotificationsChanged();
 
 private:
+    template <typename Pred>
+    void removeIf(Pred&& pred);
+    void applyChanges();
 
     WalletModel& m_walletModel;
 
     NotificationsList m_notificationsList;
+
+    struct Change
+    {
+        beam::wallet::ChangeAction action;
+        std::vector<beam::wallet::Notification> notifications;
+    };
+    std::vector<Change> m_changes;
+    QTimer m_changesTimer;
 };
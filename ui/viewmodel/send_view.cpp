@@ -24,6 +24,9 @@
 
 namespace
 {
+    // the wallet is asked once typing settles, the preview covers the gap
+    const int kCsiRefreshDelay = 300;
+
     beam::AmountBig::Type getMaxInputAmount()
     {
         // not just const because can throw and this would cause compiler warning
@@ -44,7 +47,19 @@ namespace
 SendViewModel::SendViewModel()
     : _walletModel(*AppModel::getInstance().getWalletModel())
     , _amgr(AppModel::getInstance().getAssets())
+    , _csiPreview(_walletModel)
 {
+    _csiTimer.setSingleShot(true);
+    _csiTimer.setInterval(kCsiRefreshDelay);
+    connect(&_csiTimer, &QTimer::timeout, this, &SendViewModel::RefreshCsiAsync);
+    connect(&_csiPreview, &CoinSelectionPreview::coinsChanged, this, [this]()
+    {
+        if (m_preview)
+        {
+            updatePreview();
+        }
+    });
+
     connect(&_walletModel,           &WalletModel::walletStatusChanged,        this,  &SendViewModel::balanceChanged);
     connect(&_exchangeRatesManager,  &ExchangeRatesManager::rateUnitChanged,   this,  &SendViewModel::feeRateChanged);
     connect(&_exchangeRatesManager,  &ExchangeRatesManager::activeRateChanged, this,  &SendViewModel::feeRateChanged);
@@ -59,7 +74,7 @@ beam::Amount SendViewModel::getTotalSpend() const
     auto val = m_Csi.m_requestedSum;
     if (!m_Csi.m_assetID)
     {
-        val += m_Csi.get_TotalFee();
+        val += m_preview ? m_preview->fee : m_Csi.get_TotalFee();
     }
     return val;
 }
@@ -77,7 +92,7 @@ void SendViewModel::setAssetId(int value)
         LOG_INFO () << "Selected asset id: " << value;
         m_Csi.m_assetID = valueId;
         emit assetIdChanged();
-        RefreshCsiAsync();
+        RefreshCsiPreview();
     }
 }
 
@@ -106,7 +121,7 @@ QString SendViewModel::getBeamRemaining() const
         return getAssetRemaining();
     }
 
-    const auto amount = m_Csi.m_explicitFee;
+    const auto amount = m_preview ? m_preview->fee : m_Csi.m_explicitFee;
     const auto available = beam::AmountBig::get_Lo(_walletModel.getAvailable(beam::Asset::s_BeamID));
 
     if (amount < available)
@@ -119,16 +134,24 @@ QString SendViewModel::getBeamRemaining() const
 
 QString SendViewModel::getFee() const
 {
-    return beamui::AmountToUIString(m_Csi.get_TotalFee());
+    return beamui::AmountToUIString(m_preview ? m_preview->fee : m_Csi.get_TotalFee());
 }
 
 QString SendViewModel::getChangeBeam() const
 {
+    if (m_preview)
+    {
+        return beamui::AmountToUIString(m_preview->changeBeam);
+    }
     return beamui::AmountBigToUIString(m_Csi.m_changeBeam);
 }
 
 QString SendViewModel::getChangeAsset() const
 {
+    if (m_preview)
+    {
+        return beamui::AmountToUIString(m_preview->changeAsset);
+    }
     return beamui::AmountBigToUIString(m_Csi.m_changeAsset);
 }
 
@@ -159,7 +182,7 @@ QString SendViewModel::getFeeRate() const
 
 bool SendViewModel::getIsEnough() const
 {
-    return m_Csi.m_isEnought;
+    return m_preview ? m_preview->isEnough : m_Csi.m_isEnought;
 }
 
 QString SendViewModel::getSendAmount() const
@@ -174,7 +197,7 @@ void SendViewModel::setSendAmount(const QString& value)
     {
         _maxPossible = false;
         m_Csi.m_requestedSum = amount;
-        RefreshCsiAsync();
+        RefreshCsiPreview();
     }
 }
 
@@ -185,7 +208,9 @@ bool SendViewModel::canSend() const
         return false;
     }
 
+    // only the wallet's own selection is good enough to send
     return getTokenValid() &&
+           !m_preview &&
            m_Csi.m_requestedSum > 0 &&
            m_Csi.m_isEnought;
 }
@@ -197,7 +222,7 @@ QList<QMap<QString, QVariant>> SendViewModel::getAssetsList() const
 
 QString SendViewModel::getMaxSendAmount() const
 {
-    return beamui::AmountToUIString(m_Csi.get_NettoValue());
+    return beamui::AmountToUIString(m_preview ? m_preview->maxAmount : m_Csi.get_NettoValue());
 }
 
 QString SendViewModel::getToken() const
@@ -239,47 +264,59 @@ QString SendViewModel::getNewTokenMsg() const
     return _newTokenMsg;
 }
 
-void SendViewModel::RefreshCsiAsync()
+bool SendViewModel::isShieldedSend() const
 {
-    if(m_Csi.m_requestedSum == 0UL)
-    {
-        // just reset everything to zero
-        return onSelectionCalculated(decltype(m_Csi)());
-    }
-
     using namespace beam::wallet;
     const auto type = getTokenValid() ? GetAddressType(_token.toStdString()) : TxAddressType::Unknown;
-    bool isShielded = false;
 
     switch(type)
     {
         case TxAddressType::PublicOffline:
-            isShielded = true;
-            break;
-
         case TxAddressType::MaxPrivacy:
-            isShielded = true;
-            break;
+            return true;
 
         case TxAddressType::Offline:
-            isShielded = _choiceOffline;
-            break;
-
-        case TxAddressType::Regular:
-            isShielded = false;
-            break;
+            return _choiceOffline;
 
         default:
-            isShielded = false;
-            break;
+            return false;
+    }
+}
+
+void SendViewModel::RefreshCsiPreview()
+{
+    if(m_Csi.m_requestedSum == 0UL)
+    {
+        return RefreshCsiAsync();
     }
 
+    updatePreview();
+    _csiTimer.start();
+}
+
+void SendViewModel::updatePreview()
+{
+    m_preview = _csiPreview.calculate(m_Csi.m_requestedSum, m_Csi.m_assetID, isShieldedSend());
+    emit balanceChanged();
+    emit canSendChanged();
+}
+
+void SendViewModel::RefreshCsiAsync()
+{
+    _csiTimer.stop();
+
+    if(m_Csi.m_requestedSum == 0UL)
+    {
+        // just reset everything to zero
+        m_preview.reset();
+        return onSelectionCalculated(decltype(m_Csi)());
+    }
 
     _walletModel.getAsync()->calcShieldedCoinSelectionInfo(
             m_Csi.m_requestedSum,
             0,
             m_Csi.m_assetID,
-            isShielded);
+            isShieldedSend());
 }
 
 QString SendViewModel::getTokenType() const
@@ -348,7 +385,16 @@ void SendViewModel::onSelectionCalculated(const beam::wallet::CoinsSelectionInfo
         return;
     }
 
+    if (_csiTimer.isActive())
+    {
+        // the amount was typed again, wait for the fresh answer
+        return;
+    }
+
     m_Csi = selectionRes;
+    m_preview.reset();
+    _csiPreview.reconcile(m_Csi, isShieldedSend());
+
     if (!m_Csi.m_isEnought && _maxPossible)
     {
         m_Csi.m_requestedSum = m_Csi.get_NettoValue();
@@ -14,7 +14,9 @@
 #pragma once
 
 #include <QObject>
+#include <QTimer>
 #include "model/wallet_model.h"
+#include "coin_selection_preview.h"
 #include "notifications/exchange_rates_manager.h"
 #include "wallet/assets_manager.h"
 
@@ -109,9 +111,15 @@ private:
 
 private:
     [[nodiscard]] beam::Amount getTotalSpend() const;
+    [[nodiscard]] bool isShieldedSend() const;
     void RefreshCsiAsync();
+    void RefreshCsiPreview();
+    void updatePreview();
 
     beam::wallet::CoinsSelectionInfo m_Csi;
+    // local estimate shown until the wallet answers for the current amount
+    boost::optional<CoinSelectionPreview::Result> m_preview;
+    QTimer                     _csiTimer;
     beam::wallet::WalletID     _receiverWalletID;
     beam::PeerID               _receiverIdentity;
     QString                    _comment;
@@ -122,4 +130,5 @@ private:
     QString                    _newTokenMsg;
     bool                       _choiceOffline = false;
     beam::wallet::TxParameters _txParameters;
+    CoinSelectionPreview       _csiPreview;
 };
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "utxo_item.h"
+#include "utxo_maturity.h"
 #include "model/app_model.h"
 #include "viewmodel/ui_helpers.h"
 #include "wallet/core/common.h"
@@ -118,13 +119,17 @@ beam::Height UtxoItem::rawMaturity() const
 uint16_t UtxoItem::rawMaturityTimeLeft() const
 {
     auto walletModel = AppModel::getInstance().getWalletModel();
-    if (walletModel->getCurrentHeight() < _coin.get_Maturity())
+    return static_cast<uint16_t>(utxo_maturity::hoursLeft(_coin.get_Maturity(), walletModel->getCurrentHeight()));
+}
+
+beam::Height UtxoItem::nextMaturityUpdate(beam::Height current) const
+{
+    if (!_coin.IsMaturityValid())
     {
-        auto blocksLeft = _coin.get_Maturity() - walletModel->getCurrentHeight();
-        return blocksLeft / 60;
+        return beam::MaxHeight;
     }
 
-    return 0;
+    return utxo_maturity::nextUpdate(_coin.get_Maturity(), current);
 }
 
 beam::Asset::ID UtxoItem::getAssetId() const
@@ -223,6 +228,13 @@ uint16_t ShieldedCoinItem::rawMaturityTimeLeft() const
     return _walletModel.getMaturityHoursLeft(_coin);
 }
 
+beam::Height ShieldedCoinItem::nextMaturityUpdate(beam::Height current) const
+{
+    // progress of a maturing shielded coin follows the shielded pool, not
+    // the height alone, so these few coins are refreshed on every block
+    return _coin.m_Status == beam::wallet::ShieldedCoin::Maturing ? current + 1 : beam::MaxHeight;
+}
+
 beam::Asset::ID ShieldedCoinItem::getAssetId() const
 {
     return _coin.m_CoinID.m_AssetID;
@@ -37,6 +37,10 @@ public:
     virtual beam::Amount rawAmount() const = 0;
     virtual beam::Height rawMaturity() const = 0;
     virtual uint16_t rawMaturityTimeLeft() const = 0;
+
+    // First height after the given one at which maturity roles change,
+    // beam::MaxHeight if they stay as they are
+    virtual beam::Height nextMaturityUpdate(beam::Height current) const = 0;
 };
 
 class UtxoItem : public BaseUtxoItem
@@ -58,6 +62,7 @@ public:
     beam::Amount rawAmount() const override;
     beam::Height rawMaturity() const override;
     uint16_t rawMaturityTimeLeft() const override;
+    beam::Height nextMaturityUpdate(beam::Height current) const override;
     const beam::wallet::Coin::ID& get_ID() const;
 private:
     beam::wallet::Coin _coin;
@@ -82,6 +87,7 @@ public:
     beam::Amount rawAmount() const override;
     beam::Height rawMaturity() const override;
     uint16_t rawMaturityTimeLeft() const override;
+    beam::Height nextMaturityUpdate(beam::Height current) const override;
 private:
     WalletModel& _walletModel;
     beam::wallet::ShieldedCoin _coin;
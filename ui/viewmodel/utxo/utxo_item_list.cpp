@@ -13,13 +13,18 @@
 // limitations under the License.
 
 #include "utxo_item_list.h"
+#include <array>
 #include "viewmodel/ui_helpers.h"
 #include "model/app_model.h"
 
 UtxoItemList::UtxoItemList()
     : _amgr(AppModel::getInstance().getAssets())
 {
-    connect(_amgr.get(), &AssetsManager::assetInfo, this,  &UtxoItemList::onAssetInfo);
+    auto walletModel = AppModel::getInstance().getWalletModel();
+    _height = walletModel->getCurrentHeight();
+
+    connect(_amgr.get(), &AssetsManager::assetsInfoChanged, this,  &UtxoItemList::onAssetsInfo);
+    connect(walletModel.get(), &WalletModel::walletStatusChanged, this, &UtxoItemList::onWalletStatus);
 }
 
 QHash<int, QByteArray> UtxoItemList::roleNames() const
@@ -81,17 +86,109 @@ auto UtxoItemList::data(const QModelIndex &index, int role) const -> QVariant
     }
 }
 
-void UtxoItemList::onAssetInfo(beam::Asset::ID assetId)
+void UtxoItemList::onAssetsInfo(const QSet<beam::Asset::ID>& assets)
 {
-    touch(assetId);
+    std::vector<int> rows;
+    _assetIndex.forEachKey(assets, [this, &rows](uint64_t key) {
+        const auto row = indexOf(key);
+        if (row >= 0) {
+            rows.push_back(row);
+        }
+    });
+    touchRows(std::move(rows), {static_cast<int>(Roles::UnitName)});
 }
 
-void UtxoItemList::touch(beam::Asset::ID id)
+void UtxoItemList::onWalletStatus()
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->getAssetId() == id) {
-           const auto idx = it - m_list.begin();
-           ListModel::touch(idx);
+    const auto height = AppModel::getInstance().getWalletModel()->getCurrentHeight();
+    if (height == _height)
+    {
+        return;
+    }
+
+    const bool rollback = height < _height;
+    _height = height;
+
+    std::vector<std::shared_ptr<BaseUtxoItem>> due;
+    if (rollback)
+    {
+        // matured coins may become immature again, recheck everything
+        due.assign(m_list.begin(), m_list.end());
+    }
+    else
+    {
+        // only coins whose maturity roles change at this height are touched
+        const auto end = _maturityQueue.upper_bound(height);
+        for (auto it = _maturityQueue.begin(); it != end; ++it)
+        {
+            const auto row = indexOf(it->second);
+            if (row >= 0)
+            {
+                due.push_back(m_list[row]);
+            }
         }
     }
+
+    std::vector<int> rows;
+    rows.reserve(due.size());
+    for (const auto& item : due)
+    {
+        scheduleMaturityUpdate(item);
+        rows.push_back(indexOf(item->getHash()));
+    }
+
+    touchRows(std::move(rows), {
+        static_cast<int>(Roles::MaturityPercentage),
+        static_cast<int>(Roles::MaturityPercentageSort),
+        static_cast<int>(Roles::MaturityTimeLeft),
+        static_cast<int>(Roles::MaturityTimeLeftSort)
+    });
+}
+
+void UtxoItemList::scheduleMaturityUpdate(const std::shared_ptr<BaseUtxoItem>& item)
+{
+    const auto key = item->getHash();
+    auto pos = _maturityPos.find(key);
+    if (pos != _maturityPos.end())
+    {
+        _maturityQueue.erase(pos->second);
+        _maturityPos.erase(pos);
+    }
+
+    const auto next = item->nextMaturityUpdate(_height);
+    if (next != beam::MaxHeight)
+    {
+        _maturityPos.emplace(key, _maturityQueue.emplace(next, key));
+    }
+}
+
+void UtxoItemList::onItemAdded(const std::shared_ptr<BaseUtxoItem>& item)
+{
+    _assetIndex.add(item->getHash(), std::array<beam::Asset::ID, 1>{item->getAssetId()});
+    scheduleMaturityUpdate(item);
+}
+
+void UtxoItemList::onItemRemoved(const std::shared_ptr<BaseUtxoItem>& item)
+{
+    const auto key = item->getHash();
+    _assetIndex.remove(key);
+
+    auto pos = _maturityPos.find(key);
+    if (pos != _maturityPos.end())
+    {
+        _maturityQueue.erase(pos->second);
+        _maturityPos.erase(pos);
+    }
+}
+
+void UtxoItemList::onItemsCleared()
+{
+    _assetIndex.clear();
+    _maturityQueue.clear();
+    _maturityPos.clear();
+}
+
+uint64_t UtxoItemList::keyOf(const std::shared_ptr<BaseUtxoItem>& item) const
+{
+    return item->getHash();
 }
@@ -14,11 +14,13 @@
 
 #pragma once
 
+#include <map>
+#include <unordered_map>
 #include "utxo_item.h"
 #include "viewmodel/helpers/list_model.h"
 #include "viewmodel/wallet/assets_manager.h"
 
-class UtxoItemList : public ListModel<std::shared_ptr<BaseUtxoItem>>
+class UtxoItemList : public KeyedListModel<std::shared_ptr<BaseUtxoItem>, uint64_t>
 {
     Q_OBJECT
 public:
@@ -44,9 +46,25 @@ public:
     [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
 
 public slots:
-    void onAssetInfo(beam::Asset::ID assetId);
+    void onAssetsInfo(const QSet<beam::Asset::ID>& assets);
+    void onWalletStatus();
 
 private:
-    void touch(beam::Asset::ID id);
+    using MaturityQueue = std::multimap<beam::Height, uint64_t>;
+
+    void scheduleMaturityUpdate(const std::shared_ptr<BaseUtxoItem>& item);
+
+    [[nodiscard]] uint64_t keyOf(const std::shared_ptr<BaseUtxoItem>& item) const override;
+    void onItemAdded(const std::shared_ptr<BaseUtxoItem>& item) override;
+    void onItemRemoved(const std::shared_ptr<BaseUtxoItem>& item) override;
+    void onItemsCleared() override;
+
     AssetsManager::Ptr _amgr;
+    KeyGroupIndex<beam::Asset::ID, uint64_t> _assetIndex;
+
+    // rows waiting for their maturity roles to change, keyed by the height
+    // at which that happens, matured coins are not kept here at all
+    beam::Height _height = 0;
+    MaturityQueue _maturityQueue;
+    std::unordered_map<uint64_t, MaturityQueue::iterator> _maturityPos;
 };
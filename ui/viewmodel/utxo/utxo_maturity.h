@@ -0,0 +1,39 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include "wallet/core/common.h"
+
+// Time left till maturity is shown in whole hours of blocks
+namespace utxo_maturity
+{
+    const beam::Height kBlocksPerHour = 60;
+
+    inline beam::Height hoursLeft(beam::Height maturity, beam::Height current)
+    {
+        return current < maturity ? (maturity - current) / kBlocksPerHour : 0;
+    }
+
+    // First height after the current one at which hoursLeft drops,
+    // beam::MaxHeight once it is zero and stays so
+    inline beam::Height nextUpdate(beam::Height maturity, beam::Height current)
+    {
+        const auto hours = hoursLeft(maturity, current);
+        if (hours == 0)
+        {
+            return beam::MaxHeight;
+        }
+        return maturity - hours * kBlocksPerHour + 1;
+    }
+}
@@ -54,6 +54,9 @@ void UtxoViewModel::setMaturingMaxPrivacy(bool value)
     {
         m_maturingMaxPrivacy = value;
         emit maturingMaxPrivacyChanged();
+
+        reproject();
+        emit allUtxoChanged();
     }
 }
 
@@ -69,133 +72,150 @@ void UtxoViewModel::setAssetId(unsigned int id)
         m_assetId = id;
         emit assetIdChanged();
 
-        m_model.getAsync()->getAllUtxosStatus();
+        // the index already holds every coin, no need to ask the wallet again
+        reproject();
+        emit allUtxoChanged();
     }
 }
 
 void UtxoViewModel::onNormalCoinsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& utxos)
+{
+    onCoinsChanged<UtxoItem>(m_normalCoins, action, utxos);
+}
+
+void UtxoViewModel::onShieldedCoinChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::ShieldedCoin>& items)
+{
+    onCoinsChanged<ShieldedCoinItem>(m_shieldedCoins, action, items);
+}
+
+template <typename Item, typename Coin>
+void UtxoViewModel::onCoinsChanged(CoinIndex& index, beam::wallet::ChangeAction action, const std::vector<Coin>& coins)
 {
     using namespace beam::wallet;
 
-    if (getMaturingMaxPrivacy())
-        return;
+    if (action == ChangeAction::Reset)
+    {
+        index.clear();
+    }
 
-    vector<shared_ptr<BaseUtxoItem>> modifiedItems;
-    modifiedItems.reserve(utxos.size());
+    vector<shared_ptr<BaseUtxoItem>> toInsert;
+    vector<uint64_t> toRemove;
 
-    for (const auto& t : utxos)
+    for (const auto& coin : coins)
     {
-        if (m_assetId)
+        auto item = make_shared<Item>(coin);
+        const auto key = item->getHash();
+        const auto assetId = item->getAssetId();
+
+        switch (action)
+        {
+        case ChangeAction::Reset:
+            index[assetId][key] = item;
+            break;
+
+        case ChangeAction::Removed:
         {
-            if (t.m_ID.m_AssetID != *m_assetId)
+            auto it = index.find(assetId);
+            if (it != index.end())
             {
-                continue;
+                it->second.erase(key);
+                if (it->second.empty())
+                {
+                    index.erase(it);
+                }
             }
+            toRemove.push_back(key);
+            break;
         }
 
-        modifiedItems.push_back(make_shared<UtxoItem>(t));
-    }
+        case ChangeAction::Added:
+        case ChangeAction::Updated:
+            index[assetId][key] = item;
+            if (isVisible(*item))
+            {
+                toInsert.push_back(item);
+            }
+            else
+            {
+                // an update may move a coin out of the current projection
+                toRemove.push_back(key);
+            }
+            break;
 
-    switch (action)
-    {
-    case ChangeAction::Reset:
-    {
-        m_allUtxos.reset(modifiedItems);
-        break;
+        default:
+            assert(false && "Unexpected action");
+            break;
+        }
     }
 
-    case ChangeAction::Removed:
+    if (action == ChangeAction::Reset)
     {
-        m_allUtxos.remove(modifiedItems);
-        break;
+        // normal and shielded coins share the list, rebuild both in one swap
+        reproject();
     }
-
-    case ChangeAction::Added:
+    else
     {
-        m_allUtxos.insert(modifiedItems);
-        break;
+        m_allUtxos.removeKeys(toRemove);
+        m_allUtxos.insert(toInsert);
     }
 
-    case ChangeAction::Updated:
+    emit allUtxoChanged();
+}
+
+bool UtxoViewModel::isVisible(const BaseUtxoItem& item) const
+{
+    if (m_assetId && item.getAssetId() != *m_assetId)
     {
-        m_allUtxos.update(modifiedItems);
-        break;
+        return false;
     }
 
-    default:
-        assert(false && "Unexpected action");
-        break;
+    if (getMaturingMaxPrivacy())
+    {
+        return item.type() == UtxoViewType::Shielded && item.status() == UtxoViewStatus::MaturingMP;
     }
 
-    emit allUtxoChanged();
+    return true;
 }
 
-void UtxoViewModel::onShieldedCoinChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::ShieldedCoin>& items)
+void UtxoViewModel::reproject()
 {
-    using namespace beam::wallet;
-
-    vector<shared_ptr<BaseUtxoItem>> modifiedItems;
-    modifiedItems.reserve(items.size());
+    vector<shared_ptr<BaseUtxoItem>> items;
 
-    for (const auto& t : items)
+    auto project = [&](const CoinIndex& index)
     {
-        if (m_assetId)
+        auto add = [&](const CoinMap& coins)
         {
-            if (t.m_CoinID.m_AssetID != *m_assetId)
+            for (const auto& p : coins)
             {
-                continue;
+                if (isVisible(*p.second))
+                {
+                    items.push_back(p.second);
+                }
             }
-        }
+        };
 
-        if (getMaturingMaxPrivacy() && t.m_Status != beam::wallet::ShieldedCoin::Status::Maturing)
+        if (m_assetId)
         {
-            continue;
+            auto it = index.find(*m_assetId);
+            if (it != index.end())
+            {
+                add(it->second);
+            }
         }
-
-        modifiedItems.push_back(make_shared<ShieldedCoinItem>(t));
-    }
-
-    switch (action)
-    {
-    case ChangeAction::Reset:
-    {
-        // temporary hack
-        vector<shared_ptr<BaseUtxoItem>> toRemove;
-        for (const auto& item : m_allUtxos)
+        else
         {
-            if (item->type() == UtxoViewType::EnType::Shielded)
+            for (const auto& p : index)
             {
-                toRemove.push_back(item);
+                add(p.second);
             }
         }
-        m_allUtxos.remove(toRemove);
-        m_allUtxos.insert(modifiedItems);
-        break;
-    }
+    };
 
-    case ChangeAction::Removed:
+    if (!getMaturingMaxPrivacy())
     {
-        m_allUtxos.remove(modifiedItems);
-        break;
+        project(m_normalCoins);
     }
+    project(m_shieldedCoins);
 
-    case ChangeAction::Added:
-    {
-        m_allUtxos.insert(modifiedItems);
-        break;
-    }
-
-    case ChangeAction::Updated:
-    {
-        m_allUtxos.update(modifiedItems);
-        break;
-    }
-
-    default:
-        assert(false && "Unexpected action");
-        break;
-    }
-
-    emit allUtxoChanged();
+    m_allUtxos.reset(items);
 }
-
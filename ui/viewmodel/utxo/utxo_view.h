@@ -15,6 +15,7 @@
 #pragma once
 
 #include <QObject>
+#include <unordered_map>
 #include "model/wallet_model.h"
 #include "utxo_item_list.h"
 
@@ -50,6 +51,18 @@ signals:
     void assetIdChanged();
 
 private:
+    // all known coins grouped by asset and keyed by the coin id hash,
+    // the list model shows a projection of it for the current filter
+    using CoinMap = std::unordered_map<uint64_t, std::shared_ptr<BaseUtxoItem>>;
+    using CoinIndex = std::unordered_map<beam::Asset::ID, CoinMap>;
+
+    template <typename Item, typename Coin>
+    void onCoinsChanged(CoinIndex& index, beam::wallet::ChangeAction action, const std::vector<Coin>& coins);
+    bool isVisible(const BaseUtxoItem& item) const;
+    void reproject();
+
+    CoinIndex        m_normalCoins;
+    CoinIndex        m_shieldedCoins;
     UtxoItemList     m_allUtxos;
     WalletModel&     m_model;
     bool             m_maturingMaxPrivacy = false;
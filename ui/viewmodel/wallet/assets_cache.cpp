@@ -0,0 +1,81 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "assets_cache.h"
+#include <QDataStream>
+#include "utility/logger.h"
+
+namespace
+{
+    // Bump kCacheVersion whenever the record layout changes
+    const quint32 kCacheMagic   = 0x42414d43;
+    const quint32 kCacheVersion = 1;
+}
+
+bool writeAssetsCache(QIODevice& device, const CachedAssets& assets)
+{
+    QDataStream out(&device);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << kCacheMagic << kCacheVersion << static_cast<quint32>(assets.size());
+
+    for (const auto& asset: assets)
+    {
+        const auto& meta = asset->m_Metadata.m_Value;
+        out << static_cast<quint32>(asset->m_ID)
+            << static_cast<quint64>(asset->m_LockHeight)
+            << static_cast<quint64>(asset->m_RefreshHeight)
+            << QByteArray(reinterpret_cast<const char*>(meta.data()), static_cast<int>(meta.size()));
+    }
+
+    return out.status() == QDataStream::Ok;
+}
+
+CachedAssets readAssetsCache(QIODevice& device)
+{
+    CachedAssets assets;
+
+    QDataStream in(&device);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version >> count;
+    if (in.status() != QDataStream::Ok || magic != kCacheMagic || version != kCacheVersion)
+    {
+        return assets;
+    }
+
+    for (quint32 i = 0; i < count; ++i)
+    {
+        quint32 id = 0;
+        quint64 lockHeight = 0, refreshHeight = 0;
+        QByteArray meta;
+        in >> id >> lockHeight >> refreshHeight >> meta;
+
+        if (in.status() != QDataStream::Ok || id == beam::Asset::s_InvalidID)
+        {
+            LOG_WARNING() << "Asset cache is damaged, " << i << " of " << count << " entries loaded";
+            break;
+        }
+
+        auto asset = std::make_shared<beam::wallet::WalletAsset>();
+        asset->m_ID = id;
+        asset->m_LockHeight = lockHeight;
+        asset->m_RefreshHeight = refreshHeight;
+        const auto* data = reinterpret_cast<const uint8_t*>(meta.constData());
+        asset->m_Metadata.m_Value.assign(data, data + meta.size());
+        asset->m_Metadata.UpdateHash();
+        assets.push_back(std::move(asset));
+    }
+
+    return assets;
+}
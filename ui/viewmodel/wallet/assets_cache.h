@@ -0,0 +1,28 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <QIODevice>
+#include <memory>
+#include <vector>
+#include "wallet/core/wallet_db.h"
+
+// On-disk format of the asset metadata cache: a versioned header followed by
+// id, lock height, refresh height and raw metadata of every asset
+using CachedAssets = std::vector<std::shared_ptr<beam::wallet::WalletAsset>>;
+
+bool writeAssetsCache(QIODevice& device, const CachedAssets& assets);
+
+// Files of another version give nothing, a damaged tail is dropped
+CachedAssets readAssetsCache(QIODevice& device);
@@ -11,18 +11,58 @@
 #include "assets_list.h"
 #include "model/app_model.h"
 
+namespace
+{
+    // the view passes simple and push txs only
+    bool isCountedTx(const beam::wallet::TxDescription& tx)
+    {
+        using namespace beam::wallet;
+
+        return tx.m_status == TxStatus::Pending ||
+               tx.m_status == TxStatus::InProgress ||
+               tx.m_status == TxStatus::Registering;
+    }
+
+    const QVector<int> kTxCntRoles =
+    {
+        static_cast<int>(AssetsList::Roles::RInTxCnt),
+        static_cast<int>(AssetsList::Roles::ROutTxCnt)
+    };
+
+    const QVector<int> kBalanceRoles =
+    {
+        static_cast<int>(AssetsList::Roles::RAmount),
+        static_cast<int>(AssetsList::Roles::RAmountRegular),
+        static_cast<int>(AssetsList::Roles::RAmountShielded),
+        static_cast<int>(AssetsList::Roles::RMaturingRegular),
+        static_cast<int>(AssetsList::Roles::RMaturingMP),
+        static_cast<int>(AssetsList::Roles::RMaturingTotal),
+        static_cast<int>(AssetsList::Roles::RChange),
+        static_cast<int>(AssetsList::Roles::RLocked)
+    };
+}
+
 AssetsList::AssetsList()
     : _amgr(AppModel::getInstance().getAssets())
     , _wallet(*AppModel::getInstance().getWalletModel())
+    , _txView(AppModel::getInstance().getTransactions()->makeView({beam::wallet::TxType::Simple, beam::wallet::TxType::PushTransaction}))
 {
     connect(&_ermgr,     &ExchangeRatesManager::rateUnitChanged,   this,  &AssetsList::onNewRates);
     connect(&_ermgr,     &ExchangeRatesManager::activeRateChanged, this,  &AssetsList::onNewRates);
-    connect(&_wallet,    &WalletModel::walletStatusChanged,        this,  &AssetsList::onWalletStatus);
-    connect(&_wallet,    &WalletModel::transactionsChanged,        this,  &AssetsList::onTransactionsChanged);
-    connect(_amgr.get(), &AssetsManager::assetInfo,                this,  &AssetsList::onAssetInfo);
+    connect(&_wallet,    &WalletModel::assetsStatusChanged,        this,  &AssetsList::onAssetsStatusChanged);
+    connect(_amgr.get(), &AssetsManager::assetsInfoChanged,        this,  &AssetsList::onAssetsInfo);
 
-    // Transactions table would be created later and get this for us
-    //_wallet.getAsync()->getTransactions();
+    auto store = AppModel::getInstance().getTransactions();
+    connect(_txView.get(), &TransactionsView::transactionsChanged, this, &AssetsList::onTransactionsChanged);
+
+    if (store->isLoaded())
+    {
+        onTransactionsChanged(beam::wallet::ChangeAction::Reset, store->getByType(_txView->types()));
+    }
+    else
+    {
+        store->load();
+    }
 }
 
 QHash<int, QByteArray> AssetsList::roleNames() const
@@ -91,34 +131,31 @@ QVariant AssetsList::data(const QModelIndex &index, int role) const
         case Roles::RUnitName:
             return _amgr->getUnitName(assetId, AssetsManager::NoShorten);
         case Roles::RAmount:
-            return beamui::AmountBigToUIString(_wallet.getAvailable(assetId));
+            return getBalances(assetId).amount;
         case Roles::RAmountRegular:
-            return beamui::AmountBigToUIString(_wallet.getAvailableRegular(assetId));
+            return getBalances(assetId).amountRegular;
         case Roles::RAmountShielded:
-            return beamui::AmountBigToUIString(_wallet.getAvailableShielded(assetId));
+            return getBalances(assetId).amountShielded;
         case Roles::RMaturingRegular:
-            return beamui::AmountBigToUIString(_wallet.getMaturing(assetId));
+            return getBalances(assetId).maturingRegular;
         case Roles::RMaturingMP:
-            return beamui::AmountBigToUIString(_wallet.getMatutingMP(assetId));
+            return getBalances(assetId).maturingMP;
         case Roles::RMaturingTotal:
-        {
-            auto total = _wallet.getMaturing(assetId);
-            total += _wallet.getMatutingMP(assetId);
-            return beamui::AmountBigToUIString(total);
-        }
+            return getBalances(assetId).maturingTotal;
         case Roles::RChange:
-            return beamui::AmountBigToUIString(_wallet.getReceivingChange(assetId));
+            return getBalances(assetId).change;
         case Roles::RLocked:
+            return getBalances(assetId).locked;
+        case Roles::RInTxCnt:
         {
-             auto locked = _wallet.getMaturing(assetId);
-             locked += _wallet.getMatutingMP(assetId);
-             locked += _wallet.getReceivingChange(assetId);
-             return beamui::AmountBigToUIString(locked);
+            const auto it = _txCounters.find(assetId);
+            return static_cast<qint32>(it != _txCounters.end() ? it->second.in : 0);
         }
-        case Roles::RInTxCnt:
-            return static_cast<qint32>(asset->inTxCnt());
         case Roles::ROutTxCnt:
-            return static_cast<qint32>(asset->outTxCnt());
+        {
+            const auto it = _txCounters.find(assetId);
+            return static_cast<qint32>(it != _txCounters.end() ? it->second.out : 0);
+        }
         case Roles::Search:
             return _amgr->getName(assetId) + _amgr->getUnitName(assetId, AssetsManager::NoShorten);
         case Roles::RIcon:
@@ -152,25 +189,17 @@ QVariant AssetsList::data(const QModelIndex &index, int role) const
     }
 }
 
-std::shared_ptr<AssetObject> AssetsList::get(beam::Asset::ID id)
+beam::Asset::ID AssetsList::keyOf(const std::shared_ptr<AssetObject>& item) const
 {
-     for (auto obj: m_list)
-     {
-         if (obj->id() == id)
-         {
-             return obj;
-         }
-     }
-     return std::shared_ptr<AssetObject>();
+    return static_cast<beam::Asset::ID>(item->id());
 }
 
-void AssetsList::touch(beam::Asset::ID id)
+void AssetsList::touch(beam::Asset::ID id, const QVector<int>& roles)
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->id() == id) {
-           const auto idx = it - m_list.begin();
-           ListModel::touch(idx);
-        }
+    const auto row = indexOf(id);
+    if (row >= 0)
+    {
+        touchRows({row}, roles);
     }
 }
 
@@ -179,61 +208,104 @@ void AssetsList::onNewRates()
     touch(beam::Asset::s_BeamID);
 }
 
-void AssetsList::onWalletStatus()
+void AssetsList::onAssetsStatusChanged(const std::set<beam::Asset::ID>& assets)
 {
-    for(const auto& asset: m_list)
+    std::vector<int> rows;
+    for (const auto assetId: assets)
     {
-        touch(asset->id());
+        _balances.erase(assetId);
+
+        const auto row = indexOf(assetId);
+        if (row >= 0)
+        {
+            rows.push_back(row);
+        }
     }
+    touchRows(std::move(rows), kBalanceRoles);
 }
 
-void AssetsList::onAssetInfo(beam::Asset::ID assetId)
+const AssetsList::Balances& AssetsList::getBalances(beam::Asset::ID assetId) const
 {
-    touch(assetId);
-}
+    auto it = _balances.find(assetId);
+    if (it != _balances.end())
+    {
+        return it->second;
+    }
 
-void AssetsList::onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items)
-{
-    using namespace beam::wallet;
+    Balances balances;
+    balances.amount          = beamui::AmountBigToUIString(_wallet.getAvailable(assetId));
+    balances.amountRegular   = beamui::AmountBigToUIString(_wallet.getAvailableRegular(assetId));
+    balances.amountShielded  = beamui::AmountBigToUIString(_wallet.getAvailableShielded(assetId));
+    balances.maturingRegular = beamui::AmountBigToUIString(_wallet.getMaturing(assetId));
+    balances.maturingMP      = beamui::AmountBigToUIString(_wallet.getMatutingMP(assetId));
+    balances.change          = beamui::AmountBigToUIString(_wallet.getReceivingChange(assetId));
+
+    auto total = _wallet.getMaturing(assetId);
+    total += _wallet.getMatutingMP(assetId);
+    balances.maturingTotal = beamui::AmountBigToUIString(total);
 
-    TxList modified;
+    total += _wallet.getReceivingChange(assetId);
+    balances.locked = beamui::AmountBigToUIString(total);
 
-    for (const auto& tx : items)
+    return _balances.emplace(assetId, std::move(balances)).first->second;
+}
+
+void AssetsList::onAssetsInfo(const QSet<beam::Asset::ID>& assets)
+{
+    std::vector<int> rows;
+    for (const auto assetId: assets)
     {
-        if(const auto txType = tx.GetParameter<TxType>(TxParameterID::TransactionType))
+        const auto row = indexOf(assetId);
+        if (row >= 0)
         {
-            if (txType == TxType::Simple || txType == TxType::PushTransaction)
-            {
-                modified.push_back(tx);
-            }
+            rows.push_back(row);
         }
     }
+    touchRows(std::move(rows));
+}
+
+void AssetsList::onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items)
+{
+    using namespace beam::wallet;
+
+    // counters follow status transitions, each tx costs O(1)
+    std::vector<beam::Asset::ID> changed;
 
     switch(action)
     {
     case ChangeAction::Reset:
-        _txlist.swap(modified);
+        for (const auto& counter: _txCounters)
+        {
+            changed.push_back(counter.first);
+        }
+        _txCounters.clear();
+        _activeTxs.clear();
+        for (const auto& tx : items)
+        {
+            countTx(tx, changed);
+        }
         break;
 
     case ChangeAction::Removed:
-        for(auto del: modified)
+        for (const auto& tx : items)
         {
-            _txlist.erase(std::remove_if(_txlist.begin(), _txlist.end(), [&del](const TxDescription& t) {
-                return t.m_txId == del.m_txId;
-            }), _txlist.end());
+            uncountTx(tx.m_txId, changed);
         }
         break;
 
     case ChangeAction::Added:
-        _txlist.insert(std::end(_txlist), std::begin(modified), std::end(modified));
-        break;
-
     case ChangeAction::Updated:
-        for(auto repl: modified)
+        for (const auto& tx : items)
         {
-            std::replace_if(_txlist.begin(), _txlist.end(), [&repl](const TxDescription& t) {
-                return t.m_txId == repl.m_txId;
-            }, repl);
+            const auto it = _activeTxs.find(tx.m_txId);
+            if (it != _activeTxs.end() && isCountedTx(tx) &&
+                it->second.assetId == tx.m_assetId && it->second.sender == tx.m_sender)
+            {
+                // still counted the same way
+                continue;
+            }
+            uncountTx(tx.m_txId, changed);
+            countTx(tx, changed);
         }
         break;
 
@@ -242,30 +314,45 @@ void AssetsList::onTransactionsChanged(beam::wallet::ChangeAction action, const
         break;
     }
 
-    for(auto& obj: m_list) {
-        obj->resetTxCnt();
-    }
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
 
-    for(const auto& tx: _txlist) {
-        if (auto obj = get(tx.m_assetId))
+    std::vector<int> rows;
+    rows.reserve(changed.size());
+    for (const auto assetId : changed)
+    {
+        const auto row = indexOf(assetId);
+        if (row >= 0)
         {
-            if(tx.m_status == beam::wallet::TxStatus::Pending ||
-               tx.m_status == beam::wallet::TxStatus::InProgress ||
-               tx.m_status == beam::wallet::TxStatus::Registering)
-            {
-                if (tx.m_sender)
-                {
-                    obj->addOutTx();
-                }
-                else
-                {
-                    obj->addIntTx();
-                }
-            }
+            rows.push_back(row);
         }
     }
+    touchRows(std::move(rows), kTxCntRoles);
+}
+
+void AssetsList::countTx(const beam::wallet::TxDescription& tx, std::vector<beam::Asset::ID>& changed)
+{
+    if (!isCountedTx(tx))
+    {
+        return;
+    }
+
+    auto& counters = _txCounters[tx.m_assetId];
+    tx.m_sender ? ++counters.out : ++counters.in;
+    _activeTxs[tx.m_txId] = ActiveTx{tx.m_assetId, tx.m_sender};
+    changed.push_back(tx.m_assetId);
+}
+
+void AssetsList::uncountTx(const beam::wallet::TxID& txId, std::vector<beam::Asset::ID>& changed)
+{
+    const auto it = _activeTxs.find(txId);
+    if (it == _activeTxs.end())
+    {
+        return;
+    }
 
-     for(auto& obj: m_list) {
-         touch(obj->id());
-     }
+    auto& counters = _txCounters[it->second.assetId];
+    it->second.sender ? --counters.out : --counters.in;
+    changed.push_back(it->second.assetId);
+    _activeTxs.erase(it);
 }
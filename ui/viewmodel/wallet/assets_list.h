@@ -11,12 +11,14 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include "asset_object.h"
 #include "viewmodel/helpers/list_model.h"
 #include "assets_manager.h"
+#include "model/transactions_store.h"
 #include "viewmodel/notifications/exchange_rates_manager.h"
 
-class AssetsList : public ListModel<std::shared_ptr<AssetObject>>
+class AssetsList : public KeyedListModel<std::shared_ptr<AssetObject>, beam::Asset::ID>
 {
     Q_OBJECT
 public:
@@ -59,18 +61,51 @@ public:
 
 private slots:
     void onNewRates();
-    void onWalletStatus();
-    void onAssetInfo(beam::Asset::ID assetId);
+    void onAssetsStatusChanged(const std::set<beam::Asset::ID>& assets);
+    void onAssetsInfo(const QSet<beam::Asset::ID>& assets);
     void onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items);
 
 private:
-    void touch(beam::Asset::ID id);
-    std::shared_ptr<AssetObject> get(beam::Asset::ID id);
+    // in progress txs of an asset, survive list resets
+    struct TxCounters
+    {
+        uint32_t in  = 0;
+        uint32_t out = 0;
+    };
+
+    // what an in progress tx adds to the counters
+    struct ActiveTx
+    {
+        beam::Asset::ID assetId;
+        bool sender;
+    };
+
+    [[nodiscard]] beam::Asset::ID keyOf(const std::shared_ptr<AssetObject>& item) const override;
+    void touch(beam::Asset::ID id, const QVector<int>& roles = QVector<int>());
+    void countTx(const beam::wallet::TxDescription& tx, std::vector<beam::Asset::ID>& changed);
+    void uncountTx(const beam::wallet::TxID& txId, std::vector<beam::Asset::ID>& changed);
 
     AssetsManager::Ptr _amgr;
     mutable ExchangeRatesManager _ermgr;
     WalletModel& _wallet;
+    TransactionsView::Ptr _txView;
+
+    // formatted balances, dropped when the asset status changes
+    struct Balances
+    {
+        QString amount;
+        QString amountRegular;
+        QString amountShielded;
+        QString maturingRegular;
+        QString maturingMP;
+        QString maturingTotal;
+        QString change;
+        QString locked;
+    };
+
+    const Balances& getBalances(beam::Asset::ID assetId) const;
 
-    typedef std::vector<beam::wallet::TxDescription> TxList;
-    TxList _txlist;
+    mutable std::unordered_map<beam::Asset::ID, Balances> _balances;
+    std::unordered_map<beam::Asset::ID, TxCounters> _txCounters;
+    std::unordered_map<beam::wallet::TxID, ActiveTx, BlobKeyHash> _activeTxs;
 };
@@ -12,11 +12,45 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "assets_manager.h"
+#include <QFile>
+#include <QSaveFile>
+#include "assets_cache.h"
+#include "utility/logger.h"
 
-AssetsManager::AssetsManager (WalletModel::Ptr wallet)
+namespace
+{
+    const int     kCacheSaveDelay = 1000;
+
+    // ids asked by rows within kCollectDelay go to the wallet in one batch,
+    // answers are announced together when the batch completes or after kAnnounceDelay
+    const int     kCollectDelay   = 20;
+    const int     kAnnounceDelay  = 100;
+
+    // a cached entry whose refresh isn't answered within kRefreshTimeout is given up
+    // so a single lost answer doesn't stall the rest of the queue
+    const int     kRefreshTimeout = 10000;
+}
+
+AssetsManager::AssetsManager (WalletModel::Ptr wallet, const QString& cachePath)
     : _wallet(wallet)
+    , _cachePath(cachePath)
 {
     qRegisterMetaType<beam::Asset::ID>("beam::wallet::AssetID");
+    connect(&_saveTimer, &QTimer::timeout, this, &AssetsManager::saveCache);
+    _saveTimer.setSingleShot(true);
+    _saveTimer.setInterval(kCacheSaveDelay);
+
+    connect(&_requestTimer, &QTimer::timeout, this, &AssetsManager::requestCollected);
+    _requestTimer.setSingleShot(true);
+    _requestTimer.setInterval(kCollectDelay);
+
+    connect(&_announceTimer, &QTimer::timeout, this, &AssetsManager::announceChanged);
+    _announceTimer.setSingleShot(true);
+    _announceTimer.setInterval(kAnnounceDelay);
+
+    connect(&_refreshTimer, &QTimer::timeout, this, &AssetsManager::onRefreshTimeout);
+    _refreshTimer.setSingleShot(true);
+    _refreshTimer.setInterval(kRefreshTimeout);
     connect(_wallet.get(), &WalletModel::assetInfoChanged, this, &AssetsManager::onAssetInfo);
     connect(&_exchangeRatesManager,  &ExchangeRatesManager::rateUnitChanged,   this,  &AssetsManager::assetsListChanged);
     connect(&_exchangeRatesManager,  &ExchangeRatesManager::activeRateChanged, this,  &AssetsManager::assetsListChanged);
@@ -63,25 +97,172 @@ AssetsManager::AssetsManager (WalletModel::Ptr wallet)
     _colors[17] = QColor("#ff7a21"); _colors[17].setAlpha(alpha);
     _colors[18] = QColor("#63afff"); _colors[18].setAlpha(alpha);
     _colors[19] = QColor("#c81f68"); _colors[19].setAlpha(alpha);
+
+    loadCache();
+    if (!_refreshQueue.empty())
+    {
+        QTimer::singleShot(0, this, &AssetsManager::refreshNextCached);
+    }
+}
+
+AssetsManager::~AssetsManager()
+{
+    if (_saveTimer.isActive())
+    {
+        saveCache();
+    }
+}
+
+void AssetsManager::loadCache()
+{
+    if (_cachePath.isEmpty())
+    {
+        return;
+    }
+
+    QFile file(_cachePath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    for (auto& asset: readAssetsCache(file))
+    {
+        const auto id = asset->m_ID;
+        _info[id] = std::make_pair(std::move(asset), MetaPtr());
+        _refreshQueue.push_back(id);
+    }
+}
+
+void AssetsManager::saveCache()
+{
+    _saveTimer.stop();
+    if (_cachePath.isEmpty())
+    {
+        return;
+    }
+
+    QSaveFile file(_cachePath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        LOG_WARNING() << "Failed to write asset cache " << _cachePath.toStdString();
+        return;
+    }
+
+    CachedAssets assets;
+    assets.reserve(_info.size());
+    for (const auto& info: _info)
+    {
+        assets.push_back(info.second.first);
+    }
+
+    if (!writeAssetsCache(file, assets) || !file.commit())
+    {
+        LOG_WARNING() << "Failed to write asset cache " << _cachePath.toStdString();
+    }
+}
+
+void AssetsManager::scheduleSave()
+{
+    if (!_cachePath.isEmpty() && !_saveTimer.isActive())
+    {
+        _saveTimer.start();
+    }
+}
+
+void AssetsManager::refreshNextCached()
+{
+    while (!_refreshQueue.empty())
+    {
+        const auto id = _refreshQueue.front();
+        _refreshQueue.pop_front();
+
+        // already being requested by someone else
+        if (_requested.find(id) != _requested.end())
+        {
+            continue;
+        }
+
+        _refreshing = id;
+        _refreshTimer.start();
+        collectAssetInfo(id);
+        return;
+    }
+
+    _refreshTimer.stop();
+    _refreshing = beam::Asset::s_InvalidID;
+}
+
+void AssetsManager::onRefreshTimeout()
+{
+    if (_refreshing == beam::Asset::s_InvalidID)
+    {
+        return;
+    }
+
+    // no answer, let the id be asked again later and move on
+    _requested.erase(_refreshing);
+    refreshNextCached();
 }
 
 void AssetsManager::collectAssetInfo(beam::Asset::ID assetId)
 {
     if (assetId < 1)
     {
-        emit assetInfo(assetId);
+        notifyChanged(assetId);
+        return;
     }
-    else
+
+    // don't request info multiple times
+    if (_requested.find(assetId) == _requested.end())
     {
-        // don't request info multiple times
-        if (_requested.find(assetId) == _requested.end())
+        _requested.insert(assetId);
+        _collected.push_back(assetId);
+        if (!_requestTimer.isActive())
         {
-            _requested.insert(assetId);
-            _wallet->getAsync()->getAssetInfo(assetId);
+            _requestTimer.start();
         }
     }
 }
 
+void AssetsManager::requestCollected()
+{
+    auto async = _wallet->getAsync();
+    for (const auto assetId: _collected)
+    {
+        async->getAssetInfo(assetId);
+    }
+    _collected.clear();
+}
+
+void AssetsManager::notifyChanged(beam::Asset::ID assetId)
+{
+    _changed.insert(assetId);
+
+    // whole batch answered, no need to wait any longer
+    if (_requested.empty())
+    {
+        announceChanged();
+    }
+    else if (!_announceTimer.isActive())
+    {
+        _announceTimer.start();
+    }
+}
+
+void AssetsManager::announceChanged()
+{
+    _announceTimer.stop();
+    if (_changed.isEmpty())
+    {
+        return;
+    }
+
+    QSet<beam::Asset::ID> changed;
+    changed.swap(_changed);
+    emit assetsInfoChanged(changed);
+}
+
 void AssetsManager::onAssetInfo(beam::Asset::ID id, const beam::wallet::WalletAsset& asset)
 {
     _requested.erase(id);
@@ -93,16 +274,41 @@ void AssetsManager::onAssetInfo(beam::Asset::ID id, const beam::wallet::WalletAs
         if (it != _info.end())
         {
             _info.erase(it);
-            emit assetInfo(id);
+            scheduleSave();
+            notifyChanged(id);
         }
     }
     else
     {
-        // Good info came, save and notify about change
+        // Good info came, save and notify about change. A refresh that brought
+        // the same metadata keeps the parsed meta and doesn't disturb the views
+        const auto it = _info.find(id);
+        const bool same = it != _info.end() &&
+                          it->second.first->m_LockHeight == asset.m_LockHeight &&
+                          it->second.first->m_Metadata.m_Value == asset.m_Metadata.m_Value;
+
         AssetPtr aptr = std::make_shared<beam::wallet::WalletAsset>(asset);
-        _info[id] = std::make_pair(aptr, MetaPtr());
+        if (same)
+        {
+            it->second.first = aptr;
+        }
+        else
+        {
+            _info[id] = std::make_pair(aptr, MetaPtr());
+            notifyChanged(id);
+        }
 
-        emit assetInfo(id);
+        scheduleSave();
+    }
+
+    if (_requested.empty())
+    {
+        announceChanged();
+    }
+
+    if (id == _refreshing)
+    {
+        refreshNextCached();
     }
 }
 
@@ -17,7 +17,10 @@
 #include <QColor>
 #include <QMap>
 #include <QList>
+#include <QSet>
 #include <QVariant>
+#include <QTimer>
+#include <deque>
 #include "model/wallet_model.h"
 #include "viewmodel/notifications/exchange_rates_manager.h"
 
@@ -27,8 +30,9 @@ class AssetsManager: public QObject
 public:
     typedef std::shared_ptr<AssetsManager> Ptr;
 
-    explicit AssetsManager(WalletModel::Ptr wallet);
-    ~AssetsManager() override = default;
+    // cachePath is the on-disk asset metadata cache, empty to disable it
+    AssetsManager(WalletModel::Ptr wallet, const QString& cachePath);
+    ~AssetsManager() override;
 
     // SYNC
     QString getIcon(beam::Asset::ID);
@@ -54,15 +58,26 @@ public:
     bool hasAsset(beam::Asset::ID) const;
 
 signals:
-    void assetInfo(beam::Asset::ID assetId);
+    // info of several assets arrived, emitted once per request batch
+    void assetsInfoChanged(const QSet<beam::Asset::ID>& assets);
     void assetsListChanged();
 
 private slots:
     void onAssetInfo(beam::Asset::ID, const beam::wallet::WalletAsset&);
 
 private:
-    // ASYNC
+    // ASYNC, unknown ids are collected for a short while and requested together
     void collectAssetInfo(beam::Asset::ID);
+    void requestCollected();
+    void notifyChanged(beam::Asset::ID);
+    void announceChanged();
+
+    // Cached entries are shown immediately and refreshed one at a time
+    void loadCache();
+    void saveCache();
+    void scheduleSave();
+    void refreshNextCached();
+    void onRefreshTimeout();
 
     typedef std::shared_ptr<beam::wallet::WalletAssetMeta> MetaPtr;
     typedef std::shared_ptr<beam::wallet::WalletAsset> AssetPtr;
@@ -73,6 +88,16 @@ private:
     ExchangeRatesManager _exchangeRatesManager;
     std::map<beam::Asset::ID, InfoPair> _info;
     std::set<beam::Asset::ID> _requested;
+    std::vector<beam::Asset::ID> _collected;
+    QSet<beam::Asset::ID> _changed;
+    QTimer _requestTimer;
+    QTimer _announceTimer;
+
+    QString _cachePath;
+    QTimer  _saveTimer;
+    std::deque<beam::Asset::ID> _refreshQueue;
+    beam::Asset::ID _refreshing = beam::Asset::s_InvalidID;
+    QTimer _refreshTimer;
 
     std::map<int, QColor>  _colors;
     std::map<int, QString> _icons;
@@ -38,11 +38,18 @@ QAbstractItemModel* AssetsViewModel::getAssets()
     return &_assets;
 }
 
-void AssetsViewModel::formAssetsList()
+bool AssetsViewModel::formAssetsList()
 {
     VAssets all;
 
     const auto assets = _wallet.getAssetsNZ();
+    if (static_cast<size_t>(_assets.rowCount()) == assets.size() &&
+        std::all_of(assets.begin(), assets.end(), [this](beam::Asset::ID assetId) { return _assets.contains(assetId); }))
+    {
+        // same assets, balance changes are reported by the list itself
+        return false;
+    }
+
     for (auto assetId: assets)
     {
         /* bool found = false;
@@ -63,10 +70,13 @@ void AssetsViewModel::formAssetsList()
     }
 
     _assets.reset(all);
+    return true;
 }
 
 void AssetsViewModel::onWalletStatus()
 {
-    formAssetsList();
-    emit assetsChanged();
+    if (formAssetsList())
+    {
+        emit assetsChanged();
+    }
 }
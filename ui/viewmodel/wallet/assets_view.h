@@ -34,7 +34,7 @@ private slots:
     void onWalletStatus();
 
 private:
-    void formAssetsList();
+    bool formAssetsList();
 
     AssetsList   _assets;
     WalletModel& _wallet;
@@ -0,0 +1,227 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "tx_history_exporter.h"
+#include <QDateTime>
+#include <QFile>
+#include <QRunnable>
+#include <QTextStream>
+#include "tx_object.h"
+
+namespace
+{
+    // rows between flushes and progress reports
+    const size_t kChunkRows = 1000;
+
+    QString csvField(const QString& value)
+    {
+        if (!value.contains(QLatin1Char(',')) && !value.contains(QLatin1Char('"')) && !value.contains(QLatin1Char('\n')))
+        {
+            return value;
+        }
+
+        QString res = value;
+        res.replace(QLatin1String("\""), QLatin1String("\"\""));
+        return QLatin1Char('"') + res + QLatin1Char('"');
+    }
+
+    void writeHeader(QTextStream& out)
+    {
+        out << "Type,"
+            << "Date | Time,"
+            << "Amount,"
+            << "Asset ID,"
+            << "Status,"
+            << "Sending address,"
+            << "Receiving address,"
+            << "Transaction fee,"
+            << "Transaction ID,"
+            << "Kernel ID,"
+            << "Comment\n";
+    }
+
+    void writeRow(QTextStream& out, const TxObject& tx, beam::Asset::ID assetId)
+    {
+        const char* type = tx.isContractTx() ? "Contract" : (tx.isIncome() ? "Receive" : "Send");
+
+        out << type << ','
+            << QDateTime::fromSecsSinceEpoch(tx.timeCreated()).toString("dd.MM.yyyy | HH:mm:ss") << ','
+            << csvField(tx.getAmountGeneral()) << ','
+            << assetId << ','
+            << csvField(tx.getStatus()) << ','
+            << csvField(tx.getAddressFrom()) << ','
+            << csvField(tx.getAddressTo()) << ','
+            << csvField(tx.getFee()) << ','
+            << tx.getTransactionID() << ','
+            << tx.getKernelID() << ','
+            << csvField(tx.getComment()) << '\n';
+    }
+}
+
+class TxHistoryExporter::Job : public QRunnable
+{
+public:
+    Job(TxHistoryExporter* owner, uint64_t jobId, QString path,
+        std::vector<beam::wallet::TxDescription>&& transactions,
+        std::shared_ptr<std::atomic<bool>> cancelled)
+        : _owner(owner)
+        , _jobId(jobId)
+        , _path(std::move(path))
+        , _transactions(std::move(transactions))
+        , _cancelled(std::move(cancelled))
+    {
+    }
+
+    void run() override
+    {
+        bool success = write();
+        if (!success)
+        {
+            QFile::remove(_path);
+        }
+        const bool cancelled = *_cancelled;
+
+        // the owner waits for the pool in its destructor
+        auto owner = _owner;
+        QMetaObject::invokeMethod(owner, [owner, jobId = _jobId, path = _path, success, cancelled]()
+        {
+            owner->onDone(jobId, path, success, cancelled);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    bool write()
+    {
+        QFile file(_path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            return false;
+        }
+
+        QTextStream out(&file);
+        out.setCodec("UTF-8");
+        writeHeader(out);
+
+        const size_t total = _transactions.size();
+        for (size_t i = 0; i < total; ++i)
+        {
+            if (i % kChunkRows == 0)
+            {
+                if (*_cancelled)
+                {
+                    return false;
+                }
+                out.flush();
+                reportProgress(static_cast<double>(i) / total);
+            }
+
+            // rows are dropped as soon as they are written
+            const auto assetId = _transactions[i].m_assetId;
+            TxObject tx(std::move(_transactions[i]));
+            writeRow(out, tx, assetId);
+        }
+
+        out.flush();
+        return out.status() == QTextStream::Ok && !*_cancelled;
+    }
+
+    void reportProgress(double progress)
+    {
+        auto owner = _owner;
+        QMetaObject::invokeMethod(owner, [owner, jobId = _jobId, progress]()
+        {
+            owner->onProgress(jobId, progress);
+        }, Qt::QueuedConnection);
+    }
+
+    TxHistoryExporter* _owner;
+    uint64_t _jobId;
+    QString _path;
+    std::vector<beam::wallet::TxDescription> _transactions;
+    std::shared_ptr<std::atomic<bool>> _cancelled;
+};
+
+TxHistoryExporter::TxHistoryExporter(QObject* parent)
+    : QObject(parent)
+{
+    _pool.setMaxThreadCount(1);
+}
+
+TxHistoryExporter::~TxHistoryExporter()
+{
+    cancel();
+    _pool.waitForDone();
+}
+
+void TxHistoryExporter::start(const QString& path, std::vector<beam::wallet::TxDescription> transactions)
+{
+    cancel();
+
+    _cancelled = std::make_shared<std::atomic<bool>>(false);
+    _pool.start(new Job(this, ++_jobId, path, std::move(transactions), _cancelled));
+
+    _progress = 0;
+    emit progressChanged();
+    if (!_running)
+    {
+        _running = true;
+        emit runningChanged();
+    }
+}
+
+void TxHistoryExporter::cancel()
+{
+    if (_cancelled)
+    {
+        *_cancelled = true;
+        _cancelled.reset();
+    }
+}
+
+bool TxHistoryExporter::isRunning() const
+{
+    return _running;
+}
+
+double TxHistoryExporter::getProgress() const
+{
+    return _progress;
+}
+
+void TxHistoryExporter::onProgress(uint64_t jobId, double progress)
+{
+    if (jobId == _jobId)
+    {
+        _progress = progress;
+        emit progressChanged();
+    }
+}
+
+void TxHistoryExporter::onDone(uint64_t jobId, const QString& path, bool success, bool cancelled)
+{
+    if (jobId != _jobId)
+    {
+        return;
+    }
+
+    _cancelled.reset();
+    _progress = success ? 1 : 0;
+    _running = false;
+    emit progressChanged();
+    emit runningChanged();
+
+    if (!success && !cancelled)
+    {
+        emit failed(path);
+    }
+}
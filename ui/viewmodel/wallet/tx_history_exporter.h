@@ -0,0 +1,57 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <QObject>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "wallet/core/common.h"
+
+// Writes transaction history as CSV on a worker thread, chunk by chunk,
+// straight into the target file. Progress and failures are reported
+// on the owner thread, a partial file is removed.
+class TxHistoryExporter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TxHistoryExporter(QObject* parent = nullptr);
+    ~TxHistoryExporter() override;
+
+    // a running export is cancelled
+    void start(const QString& path, std::vector<beam::wallet::TxDescription> transactions);
+    void cancel();
+
+    [[nodiscard]] bool isRunning() const;
+    [[nodiscard]] double getProgress() const;
+
+signals:
+    void runningChanged();
+    void progressChanged();
+    // not emitted for a cancelled export
+    void failed(const QString& path);
+
+private:
+    class Job;
+
+    void onProgress(uint64_t jobId, double progress);
+    void onDone(uint64_t jobId, const QString& path, bool success, bool cancelled);
+
+    QThreadPool _pool;
+    std::shared_ptr<std::atomic<bool>> _cancelled;
+    uint64_t _jobId = 0;
+    bool _running = false;
+    double _progress = 0;
+};
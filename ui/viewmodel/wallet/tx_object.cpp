@@ -161,6 +161,16 @@ bool TxObject::operator==(const TxObject& other) const
     return getTxID() == other.getTxID();
 }
 
+bool TxObject::isUpToDate(const beam::wallet::TxDescription& tx, const beam::wallet::Currency& secondCurrency) const
+{
+    return _tx.m_txId == tx.m_txId
+        && _tx.m_modifyTime == tx.m_modifyTime
+        && _tx.m_status == tx.m_status
+        && _tx.m_failureReason == tx.m_failureReason
+        && _tx.m_kernelID == tx.m_kernelID
+        && !(_secondCurrency != secondCurrency);
+}
+
 beam::Timestamp TxObject::timeCreated() const
 {
     return _tx.m_createTime;
@@ -244,6 +254,15 @@ QString TxObject::getRate() const
 }
 
 QString TxObject::getStatus() const
+{
+    if (_status.isEmpty())
+    {
+        _status = getStatusImpl();
+    }
+    return _status;
+}
+
+QString TxObject::getStatusImpl() const
 {
     if (_tx.m_txType == wallet::TxType::Simple)
     {
@@ -328,6 +347,15 @@ QString TxObject::getAmountGeneral() const
 
 
 QString TxObject::getFee() const
+{
+    if (!_fee)
+    {
+        _fee = getFeeImpl();
+    }
+    return *_fee;
+}
+
+QString TxObject::getFeeImpl() const
 {
     if (isContractTx())
     {
@@ -369,7 +397,11 @@ QString TxObject::getKernelID() const
 
 QString TxObject::getTransactionID() const
 {
-    return QString::fromStdString(to_hex(_tx.m_txId.data(), _tx.m_txId.size()));
+    if (_txIDStr.isEmpty())
+    {
+        _txIDStr = QString::fromStdString(to_hex(_tx.m_txId.data(), _tx.m_txId.size()));
+    }
+    return _txIDStr;
 }
 
 QString TxObject::getReasonString(beam::wallet::TxFailureReason reason) const
@@ -556,18 +588,29 @@ QString TxObject::getStateDetails() const
 
 QString TxObject::getToken() const
 {
-    const auto& tx = getTxDescription();
-    return QString::fromStdString(tx.getToken());
+    if (!_token)
+    {
+        _token = QString::fromStdString(getTxDescription().getToken());
+    }
+    return *_token;
 }
 
 QString TxObject::getSenderIdentity() const
 {
-    return QString::fromStdString(_tx.getSenderIdentity());
+    if (!_senderIdentity)
+    {
+        _senderIdentity = QString::fromStdString(_tx.getSenderIdentity());
+    }
+    return *_senderIdentity;
 }
 
 QString TxObject::getReceiverIdentity() const
 {
-    return QString::fromStdString(_tx.getReceiverIdentity());
+    if (!_receiverIdentity)
+    {
+        _receiverIdentity = QString::fromStdString(_tx.getReceiverIdentity());
+    }
+    return *_receiverIdentity;
 }
 
 bool TxObject::isMultiAsset() const
@@ -678,6 +721,36 @@ void TxObject::restoreAddressType()
     _tx.SetParameter(beam::wallet::TxParameterID::AddressType, *_addressType);
 }
 
+const QVariant* TxObject::getCachedRole(int slot) const
+{
+    if (slot < 0 || slot >= static_cast<int>(_roleCache.size()) || !_roleCache[slot].isValid())
+    {
+        return nullptr;
+    }
+    return &_roleCache[slot];
+}
+
+void TxObject::setCachedRole(int slot, const QVariant& value) const
+{
+    if (slot < 0)
+    {
+        return;
+    }
+    if (slot >= static_cast<int>(_roleCache.size()))
+    {
+        _roleCache.resize(slot + 1);
+    }
+    _roleCache[slot] = value;
+}
+
+void TxObject::clearCachedRole(int slot) const
+{
+    if (slot >= 0 && slot < static_cast<int>(_roleCache.size()))
+    {
+        _roleCache[slot] = QVariant();
+    }
+}
+
 const std::vector<beam::Asset::ID>& TxObject::getAssetsList() const
 {
     return _assetsList;
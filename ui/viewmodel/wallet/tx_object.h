@@ -28,6 +28,7 @@ public:
     explicit TxObject(beam::wallet::TxDescription tx, QObject* parent = nullptr);
     TxObject(beam::wallet::TxDescription tx, beam::wallet::Currency secondCurrency, QObject* parent = nullptr);
     bool operator==(const TxObject& other) const;
+    bool isUpToDate(const beam::wallet::TxDescription& tx, const beam::wallet::Currency& secondCurrency) const;
 
     beam::Timestamp timeCreated() const;
     beam::wallet::TxID getTxID() const;
@@ -75,10 +76,19 @@ public:
     virtual bool isFailed() const;
     virtual bool isMultiAsset() const;
 
+    // display values memoized by the owning list, slot is role - Qt::UserRole - 1.
+    // The object is rebuilt on every tx revision, so only locale and
+    // asset info changes have to clear them
+    [[nodiscard]] const QVariant* getCachedRole(int slot) const;
+    void setCachedRole(int slot, const QVariant& value) const;
+    void clearCachedRole(int slot) const;
+
 protected:
     [[nodiscard]] const beam::wallet::TxDescription& getTxDescription() const;
     [[nodiscard]] QString getReasonString(beam::wallet::TxFailureReason reason) const;
     [[nodiscard]] QString getIdentity(bool isSender) const;
+    [[nodiscard]] QString getStatusImpl() const;
+    [[nodiscard]] QString getFeeImpl() const;
     void restoreAddressType();
 
     beam::wallet::TxDescription _tx;
@@ -86,7 +96,14 @@ protected:
     QString _amountSecondCurrency;
 
     mutable QString _kernelIDStr;
+    mutable QString _txIDStr;
+    mutable QString _status;
+    mutable boost::optional<QString> _fee;
+    mutable boost::optional<QString> _token;
+    mutable boost::optional<QString> _senderIdentity;
+    mutable boost::optional<QString> _receiverIdentity;
     mutable QString _comment;
+    mutable std::vector<QVariant> _roleCache;
     boost::optional<beam::wallet::TxAddressType> _addressType;
 
     beam::Amount _contractFee = 0UL;
@@ -0,0 +1,142 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "tx_object_builder.h"
+#include <QRunnable>
+#include <QThread>
+#include <atomic>
+
+namespace
+{
+    // batches smaller than this are built inline, it is not worth a thread hop
+    const size_t kChunkSize = 256;
+}
+
+struct TxObjectBuilder::Batch
+{
+    std::vector<beam::wallet::TxDescription> txs;
+    beam::wallet::Currency secondCurrency;
+    Objects objects;
+    Callback callback;
+    std::atomic<size_t> chunksLeft {0};
+    bool done = false; // owner thread only
+};
+
+class TxObjectBuilder::BuildChunk : public QRunnable
+{
+public:
+    BuildChunk(TxObjectBuilder* owner, uint64_t seq, std::shared_ptr<Batch> batch, size_t from, size_t to)
+        : _owner(owner)
+        , _target(owner->thread())
+        , _seq(seq)
+        , _batch(std::move(batch))
+        , _from(from)
+        , _to(to)
+    {
+    }
+
+    void run() override
+    {
+        for (auto i = _from; i < _to; ++i)
+        {
+            auto obj = std::make_shared<TxObject>(_batch->txs[i], _batch->secondCurrency);
+            obj->moveToThread(_target);
+            _batch->objects[i] = std::move(obj);
+        }
+
+        if (_batch->chunksLeft.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // owner waits for the pool in its destructor, so it is alive here
+            auto owner = _owner;
+            auto seq = _seq;
+            QMetaObject::invokeMethod(owner, [owner, seq]() { owner->onBatchBuilt(seq); }, Qt::QueuedConnection);
+        }
+    }
+
+private:
+    TxObjectBuilder* _owner;
+    QThread* _target;
+    uint64_t _seq;
+    std::shared_ptr<Batch> _batch;
+    size_t _from;
+    size_t _to;
+};
+
+TxObjectBuilder::TxObjectBuilder(QObject* parent)
+    : QObject(parent)
+{
+}
+
+TxObjectBuilder::~TxObjectBuilder()
+{
+    _pool.clear();
+    _pool.waitForDone();
+}
+
+void TxObjectBuilder::build(std::vector<beam::wallet::TxDescription> txs, beam::wallet::Currency secondCurrency, Callback callback)
+{
+    if (_pending.empty() && txs.size() < kChunkSize)
+    {
+        Objects objects;
+        objects.reserve(txs.size());
+        for (const auto& tx : txs)
+        {
+            objects.push_back(std::make_shared<TxObject>(tx, secondCurrency));
+        }
+        callback(std::move(objects));
+        return;
+    }
+
+    const auto seq = _nextSeq++;
+    auto batch = std::make_shared<Batch>();
+    batch->txs = std::move(txs);
+    batch->secondCurrency = std::move(secondCurrency);
+    batch->objects.resize(batch->txs.size());
+    batch->callback = std::move(callback);
+    _pending[seq] = batch;
+
+    const auto total = batch->txs.size();
+    const auto chunks = (total + kChunkSize - 1) / kChunkSize;
+    if (chunks == 0)
+    {
+        batch->done = true;
+        flush();
+        return;
+    }
+
+    batch->chunksLeft = chunks;
+    for (size_t from = 0; from < total; from += kChunkSize)
+    {
+        _pool.start(new BuildChunk(this, seq, batch, from, std::min(from + kChunkSize, total)));
+    }
+}
+
+void TxObjectBuilder::onBatchBuilt(uint64_t seq)
+{
+    auto it = _pending.find(seq);
+    if (it != _pending.end())
+    {
+        it->second->done = true;
+        flush();
+    }
+}
+
+void TxObjectBuilder::flush()
+{
+    while (!_pending.empty() && _pending.begin()->second->done)
+    {
+        auto batch = _pending.begin()->second;
+        _pending.erase(_pending.begin());
+        batch->callback(std::move(batch->objects));
+    }
+}
@@ -0,0 +1,49 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <QObject>
+#include <QThreadPool>
+#include <functional>
+#include <memory>
+#include <map>
+#include "tx_object.h"
+
+// Builds TxObjects for incoming transaction batches on a worker pool.
+// Results are handed back on the owner thread, one callback per batch,
+// strictly in the order batches were submitted.
+class TxObjectBuilder : public QObject
+{
+    Q_OBJECT
+public:
+    using Objects  = std::vector<std::shared_ptr<TxObject>>;
+    using Callback = std::function<void(Objects&&)>;
+
+    explicit TxObjectBuilder(QObject* parent = nullptr);
+    ~TxObjectBuilder() override;
+
+    // An empty batch just keeps the callback in order with the previous ones
+    void build(std::vector<beam::wallet::TxDescription> txs, beam::wallet::Currency secondCurrency, Callback callback);
+
+private:
+    struct Batch;
+    class BuildChunk;
+
+    void onBatchBuilt(uint64_t seq);
+    void flush();
+
+    QThreadPool _pool;
+    uint64_t _nextSeq = 0;
+    std::map<uint64_t, std::shared_ptr<Batch>> _pending;
+};
@@ -182,12 +182,118 @@ public offline" */
     }
 }
 
+QString getSearchString(const TxObject& tx)
+{
+    QString r = tx.getTransactionID();
+    r.append(" ");
+    r.append(tx.getKernelID());
+    r.append(" ");
+    r.append(tx.getAddressFrom());
+    r.append(" ");
+    r.append(tx.getAddressTo());
+    r.append(" ");
+    r.append(tx.getComment());
+    r.append(" ");
+    r.append(tx.getSenderIdentity());
+    r.append(" ");
+    r.append(tx.getReceiverIdentity());
+    r.append(" ");
+    r.append(tx.getToken());
+    return r;
+}
+
+// wait for the user to stop typing
+const int kSearchDelay = 250;
+
+// strings and lists worth keeping per row, cheap flags are not cached.
+// State details count down with the height, they are never cached
+bool isMemoizedRole(int role)
+{
+    switch (static_cast<TxObjectList::Roles>(role))
+    {
+        case TxObjectList::Roles::TimeCreated:
+        case TxObjectList::Roles::AmountGeneral:
+        case TxObjectList::Roles::AmountGeneralSort:
+        case TxObjectList::Roles::AmountSecondCurrency:
+        case TxObjectList::Roles::AmountSecondCurrencySort:
+        case TxObjectList::Roles::Rate:
+        case TxObjectList::Roles::FeeRate:
+        case TxObjectList::Roles::AddressFrom:
+        case TxObjectList::Roles::AddressTo:
+        case TxObjectList::Roles::Status:
+        case TxObjectList::Roles::StatusSort:
+        case TxObjectList::Roles::Fee:
+        case TxObjectList::Roles::FailureReason:
+        case TxObjectList::Roles::AssetNames:
+        case TxObjectList::Roles::AssetNamesSort:
+        case TxObjectList::Roles::AssetFilter:
+        case TxObjectList::Roles::AssetIcons:
+        case TxObjectList::Roles::AssetAmounts:
+        case TxObjectList::Roles::AssetAmountsIncome:
+        case TxObjectList::Roles::AssetRates:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const QVector<int> kLocaleRoles =
+{
+    static_cast<int>(TxObjectList::Roles::TimeCreated),
+    static_cast<int>(TxObjectList::Roles::Status),
+    static_cast<int>(TxObjectList::Roles::StatusSort),
+    static_cast<int>(TxObjectList::Roles::FailureReason),
+    static_cast<int>(TxObjectList::Roles::StateDetails)
+};
+
+const QVector<int> kAssetRoles =
+{
+    static_cast<int>(TxObjectList::Roles::AssetNames),
+    static_cast<int>(TxObjectList::Roles::AssetNamesSort),
+    static_cast<int>(TxObjectList::Roles::AssetIcons)
+};
+
 }  // namespace
 
 TxObjectList::TxObjectList()
     : _amgr(AppModel::getInstance().getAssets())
 {
-    connect(_amgr.get(), &AssetsManager::assetInfo, this, &TxObjectList::onAssetInfo);
+    connect(_amgr.get(), &AssetsManager::assetsInfoChanged, this, &TxObjectList::onAssetsInfo);
+    connect(&AppModel::getInstance().getSettings(), &WalletSettings::localeChanged, this, &TxObjectList::onLocaleChanged);
+
+    auto walletModel = AppModel::getInstance().getWalletModel();
+    _height = walletModel->getCurrentHeight();
+    connect(walletModel.get(), &WalletModel::walletStatusChanged, this, &TxObjectList::onWalletStatus);
+
+    _searchTimer.setSingleShot(true);
+    _searchTimer.setInterval(kSearchDelay);
+    connect(&_searchTimer, &QTimer::timeout, this, &TxObjectList::applySearch);
+
+    // connected before any view, so the index is up to date when they refilter
+    connect(this, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex&, int first, int last)
+    {
+        indexRows(first, last);
+    });
+    connect(this, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles)
+    {
+        // search text is built from the tx itself, role only changes
+        // like state details or asset names don't touch it
+        if (roles.isEmpty() || roles.contains(static_cast<int>(Roles::Search)))
+        {
+            indexRows(topLeft.row(), bottomRight.row());
+        }
+    });
+    connect(this, &QAbstractItemModel::rowsAboutToBeRemoved, this, [this](const QModelIndex&, int first, int last)
+    {
+        unindexRows(first, last);
+    });
+    connect(this, &QAbstractItemModel::modelReset, this, [this]()
+    {
+        if (_searchIndexed)
+        {
+            buildSearchIndex();
+        }
+    });
 }
 
 QHash<int, QByteArray> TxObjectList::roleNames() const
@@ -246,7 +352,8 @@ QHash<int, QByteArray> TxObjectList::roleNames() const
         { static_cast<int>(Roles::AssetRates), "assetRates"},
         { static_cast<int>(Roles::CidsStr), "cidsStr"},
         { static_cast<int>(Roles::Source), "source"},
-        { static_cast<int>(Roles::SourceSort), "sourceSort"}
+        { static_cast<int>(Roles::SourceSort), "sourceSort"},
+        { static_cast<int>(Roles::SearchMatch), "searchMatch"}
     };
     return roles;
 }
@@ -259,6 +366,24 @@ QVariant TxObjectList::data(const QModelIndex &index, int role) const
     }
     
     auto& value = m_list[index.row()];
+    if (!isMemoizedRole(role))
+    {
+        return roleValue(value, role);
+    }
+
+    const int slot = role - static_cast<int>(Roles::TimeCreated);
+    if (const auto* cached = value->getCachedRole(slot))
+    {
+        return *cached;
+    }
+
+    auto res = roleValue(value, role);
+    value->setCachedRole(slot, res);
+    return res;
+}
+
+QVariant TxObjectList::roleValue(const std::shared_ptr<TxObject>& value, int role) const
+{
     switch (static_cast<Roles>(role))
     {
         case Roles::Source:
@@ -341,24 +466,9 @@ QVariant TxObjectList::data(const QModelIndex &index, int role) const
         case Roles::RawTxID:
             return QVariant::fromValue(value->getTxID());
         case Roles::Search: 
-        {
-            QString r = value->getTransactionID();
-            r.append(" ");
-            r.append(value->getKernelID());
-            r.append(" ");
-            r.append(value->getAddressFrom());
-            r.append(" ");
-            r.append(value->getAddressTo());
-            r.append(" ");
-            r.append(value->getComment());
-            r.append(" ");
-            r.append(value->getSenderIdentity());
-            r.append(" ");
-            r.append(value->getReceiverIdentity());
-            r.append(" ");
-            r.append(value->getToken());
-            return r;
-        }
+            return getSearchString(*value);
+        case Roles::SearchMatch:
+            return !_searchActive || _matches.count(value->getTxID()) > 0;
         case Roles::StateDetails:
             return value->getStateDetails();
         case Roles::Token:
@@ -451,15 +561,225 @@ QVariant TxObjectList::data(const QModelIndex &index, int role) const
     }
 }
 
-void TxObjectList::onAssetInfo(beam::Asset::ID assetId)
+beam::wallet::TxID TxObjectList::keyOf(const std::shared_ptr<TxObject>& item) const
+{
+    return item->getTxID();
+}
+
+void TxObjectList::onItemAdded(const std::shared_ptr<TxObject>& item)
+{
+    _assetIndex.add(item->getTxID(), item->getAssetsList());
+}
+
+void TxObjectList::onItemRemoved(const std::shared_ptr<TxObject>& item)
+{
+    _assetIndex.remove(item->getTxID());
+}
+
+void TxObjectList::onItemsCleared()
+{
+    _assetIndex.clear();
+}
+
+void TxObjectList::onAssetsInfo(const QSet<beam::Asset::ID>& assets)
+{
+    std::vector<int> rows;
+    _assetIndex.forEachKey(assets, [this, &rows](const beam::wallet::TxID& txId)
+    {
+        const auto row = indexOf(txId);
+        if (row >= 0)
+        {
+            rows.push_back(row);
+            clearCachedRoles(*m_list[row], kAssetRoles);
+        }
+    });
+    touchRows(std::move(rows), kAssetRoles);
+}
+
+void TxObjectList::onLocaleChanged()
+{
+    if (m_list.isEmpty())
+    {
+        return;
+    }
+
+    for (const auto& tx : m_list)
+    {
+        clearCachedRoles(*tx, kLocaleRoles);
+    }
+    emit dataChanged(index(0), index(m_list.size() - 1), kLocaleRoles);
+}
+
+void TxObjectList::onWalletStatus()
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it)
+    const auto height = AppModel::getInstance().getWalletModel()->getCurrentHeight();
+    if (height == _height)
+    {
+        return;
+    }
+    _height = height;
+
+    // countdowns of active transactions depend on the height
+    std::vector<int> rows;
+    for (int row = 0; row < m_list.size(); ++row)
     {
-        const auto& alist = (*it)->getAssetsList();
-        if(std::find(alist.begin(), alist.end(), assetId) != alist.end())
+        const auto& tx = m_list[row];
+        if (tx->isInProgress() || tx->isPending())
         {
-            const auto idx = it - m_list.begin();
-            ListModel::touch(idx);
+            rows.push_back(row);
         }
     }
+    touchRows(std::move(rows), {static_cast<int>(Roles::StateDetails)});
+}
+
+void TxObjectList::clearCachedRoles(const TxObject& tx, const QVector<int>& roles)
+{
+    for (const auto role : roles)
+    {
+        tx.clearCachedRole(role - static_cast<int>(Roles::TimeCreated));
+    }
+}
+
+QString TxObjectList::getSearchText() const
+{
+    return _searchText;
+}
+
+void TxObjectList::setSearchText(const QString& text)
+{
+    if (_searchText != text)
+    {
+        _searchText = text;
+        _searchTimer.start();
+        emit searchTextChanged();
+    }
+}
+
+void TxObjectList::applySearch()
+{
+    const QString query = _searchText.trimmed().toCaseFolded();
+    const bool active = !query.isEmpty();
+
+    if (active && !_searchIndexed)
+    {
+        buildSearchIndex();
+    }
+
+    TxSearchIndex::Matches matches;
+    if (active)
+    {
+        matches = _searchIndex.find(query);
+    }
+
+    // only rows that cross the filter boundary are reported
+    std::vector<int> rows;
+    const auto touch = [&](const beam::wallet::TxID& id)
+    {
+        const int row = indexOf(id);
+        if (row >= 0)
+        {
+            rows.push_back(row);
+        }
+    };
+
+    if (active && _searchActive)
+    {
+        for (const auto& id : _matches)
+        {
+            if (!matches.count(id)) touch(id);
+        }
+        for (const auto& id : matches)
+        {
+            if (!_matches.count(id)) touch(id);
+        }
+    }
+    else if (active != _searchActive)
+    {
+        const auto& visible = active ? matches : _matches;
+        for (int row = 0; row < m_list.size(); ++row)
+        {
+            if (!visible.count(m_list[row]->getTxID()))
+            {
+                rows.push_back(row);
+            }
+        }
+    }
+
+    _matches.swap(matches);
+    _searchActive = active;
+    _searchQuery = query;
+
+    touchRows(std::move(rows), { static_cast<int>(Roles::SearchMatch) });
+}
+
+void TxObjectList::buildSearchIndex()
+{
+    _searchIndex.clear();
+    _searchIndexed = true;
+    indexRows(0, m_list.size() - 1);
+
+    if (_searchActive)
+    {
+        _matches = _searchIndex.find(_searchQuery);
+    }
+}
+
+void TxObjectList::indexRows(int first, int last)
+{
+    if (!_searchIndexed)
+    {
+        return;
+    }
+
+    for (int row = std::max(first, 0); row <= last && row < m_list.size(); ++row)
+    {
+        const auto& tx = *m_list[row];
+        const auto& id = tx.getTxID();
+        _searchIndex.put(id, getSearchString(tx));
+
+        if (_searchActive)
+        {
+            if (_searchIndex.matches(id, _searchQuery))
+            {
+                _matches.insert(id);
+            }
+            else
+            {
+                _matches.erase(id);
+            }
+        }
+    }
+}
+
+void TxObjectList::unindexRows(int first, int last)
+{
+    if (!_searchIndexed)
+    {
+        return;
+    }
+
+    for (int row = std::max(first, 0); row <= last && row < m_list.size(); ++row)
+    {
+        const auto& id = m_list[row]->getTxID();
+        _searchIndex.remove(id);
+        _matches.erase(id);
+    }
+}
+
+bool TxObjectList::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && _canFetchMore;
+}
+
+void TxObjectList::fetchMore(const QModelIndex& parent)
+{
+    if (canFetchMore(parent))
+    {
+        emit fetchMoreRequested();
+    }
+}
+
+void TxObjectList::setCanFetchMore(bool value)
+{
+    _canFetchMore = value;
 }
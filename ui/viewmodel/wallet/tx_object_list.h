@@ -17,11 +17,15 @@
 #include "tx_object.h"
 #include "viewmodel/helpers/list_model.h"
 #include "assets_manager.h"
+#include "tx_search_index.h"
 #include <QLocale>
+#include <QTimer>
 
-class TxObjectList : public ListModel<std::shared_ptr<TxObject>>
+class TxObjectList : public KeyedListModel<std::shared_ptr<TxObject>, beam::wallet::TxID, BlobKeyHash>
 {
     Q_OBJECT
+    // filter rows through the SearchMatch role, queries are debounced
+    Q_PROPERTY(QString searchText READ getSearchText WRITE setSearchText NOTIFY searchTextChanged)
 public:
     enum class Roles: int
     {
@@ -78,6 +82,7 @@ public:
         CidsStr,
         Source,
         SourceSort,
+        SearchMatch,
     };
     Q_ENUM(Roles)
 
@@ -86,10 +91,49 @@ public:
     [[nodiscard]] QVariant data(const QModelIndex &index, int role) const override;
     [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
 
+    [[nodiscard]] QString getSearchText() const;
+    void setSearchText(const QString& text);
+
+    // rows are loaded by pages, the owner feeds them on fetchMoreRequested
+    [[nodiscard]] bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+    void setCanFetchMore(bool value);
+
+signals:
+    void searchTextChanged();
+    void fetchMoreRequested();
+
 private slots:
-    void onAssetInfo(beam::Asset::ID assetId);
+    void onAssetsInfo(const QSet<beam::Asset::ID>& assets);
+    void onLocaleChanged();
+    void onWalletStatus();
+    void applySearch();
 
 private:
+    [[nodiscard]] beam::wallet::TxID keyOf(const std::shared_ptr<TxObject>& item) const override;
+    void onItemAdded(const std::shared_ptr<TxObject>& item) override;
+    void onItemRemoved(const std::shared_ptr<TxObject>& item) override;
+    void onItemsCleared() override;
+    [[nodiscard]] QVariant roleValue(const std::shared_ptr<TxObject>& value, int role) const;
+    static void clearCachedRoles(const TxObject& tx, const QVector<int>& roles);
+
+    void buildSearchIndex();
+    void indexRows(int first, int last);
+    void unindexRows(int first, int last);
+
     AssetsManager::Ptr _amgr;
     QLocale m_locale;
+    beam::Height _height = 0;
+    KeyGroupIndex<beam::Asset::ID, beam::wallet::TxID, BlobKeyHash> _assetIndex;
+
+    // the index is built on the first search and maintained from then on
+    TxSearchIndex _searchIndex;
+    bool _searchIndexed = false;
+    bool _searchActive = false;
+    QString _searchText;
+    QString _searchQuery; // case folded
+    TxSearchIndex::Matches _matches;
+    QTimer _searchTimer;
+
+    bool _canFetchMore = false;
 };
@@ -0,0 +1,175 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "tx_search_index.h"
+#include <algorithm>
+
+namespace
+{
+    // do not bother sweeping small indexes
+    const size_t kMinDeadToCompact = 1024;
+}
+
+void TxSearchIndex::put(const TxID& id, const QString& text)
+{
+    QString folded = text.toCaseFolded();
+
+    auto it = _docOf.find(id);
+    if (it != _docOf.end())
+    {
+        auto& doc = _docs[it->second];
+        if (doc.text == folded)
+        {
+            return;
+        }
+        doc.alive = false;
+        doc.text.clear();
+        ++_dead;
+    }
+
+    const auto docId = static_cast<uint32_t>(_docs.size());
+    _docs.push_back({id, std::move(folded)});
+    _docOf[id] = docId;
+    addPostings(docId);
+
+    compact();
+}
+
+void TxSearchIndex::remove(const TxID& id)
+{
+    auto it = _docOf.find(id);
+    if (it == _docOf.end())
+    {
+        return;
+    }
+
+    auto& doc = _docs[it->second];
+    doc.alive = false;
+    doc.text.clear();
+    _docOf.erase(it);
+    ++_dead;
+
+    compact();
+}
+
+void TxSearchIndex::clear()
+{
+    _docs.clear();
+    _docOf.clear();
+    _postings.clear();
+    _dead = 0;
+}
+
+TxSearchIndex::Matches TxSearchIndex::find(const QString& query) const
+{
+    Matches res;
+    if (query.isEmpty())
+    {
+        return res;
+    }
+
+    const auto accept = [&](const Doc& doc)
+    {
+        if (doc.alive && doc.text.contains(query))
+        {
+            res.insert(doc.id);
+        }
+    };
+
+    if (query.size() < 3)
+    {
+        std::for_each(_docs.begin(), _docs.end(), accept);
+        return res;
+    }
+
+    std::vector<Gram> grams;
+    collectGrams(query, grams);
+
+    const std::vector<uint32_t>* rarest = nullptr;
+    for (const auto gram : grams)
+    {
+        auto it = _postings.find(gram);
+        if (it == _postings.end())
+        {
+            return res;
+        }
+        if (!rarest || it->second.size() < rarest->size())
+        {
+            rarest = &it->second;
+        }
+    }
+
+    for (const auto docId : *rarest)
+    {
+        accept(_docs[docId]);
+    }
+    return res;
+}
+
+bool TxSearchIndex::matches(const TxID& id, const QString& query) const
+{
+    auto it = _docOf.find(id);
+    return it != _docOf.end() && _docs[it->second].text.contains(query);
+}
+
+void TxSearchIndex::collectGrams(const QString& text, std::vector<Gram>& grams)
+{
+    grams.clear();
+    for (int i = 2; i < text.size(); ++i)
+    {
+        grams.push_back(static_cast<Gram>(text[i - 2].unicode()) << 32
+                      | static_cast<Gram>(text[i - 1].unicode()) << 16
+                      | static_cast<Gram>(text[i].unicode()));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+}
+
+void TxSearchIndex::addPostings(uint32_t docId)
+{
+    std::vector<Gram> grams;
+    collectGrams(_docs[docId].text, grams);
+    for (const auto gram : grams)
+    {
+        _postings[gram].push_back(docId);
+    }
+}
+
+void TxSearchIndex::compact()
+{
+    if (_dead < kMinDeadToCompact || _dead < _docOf.size())
+    {
+        return;
+    }
+
+    std::vector<Doc> docs;
+    docs.reserve(_docOf.size());
+    for (auto& doc : _docs)
+    {
+        if (doc.alive)
+        {
+            docs.push_back(std::move(doc));
+        }
+    }
+
+    _docs.swap(docs);
+    _postings.clear();
+    _docOf.clear();
+    _dead = 0;
+
+    for (uint32_t docId = 0; docId < _docs.size(); ++docId)
+    {
+        _docOf[_docs[docId].id] = docId;
+        addPostings(docId);
+    }
+}
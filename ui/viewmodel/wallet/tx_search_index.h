@@ -0,0 +1,60 @@
+// Copyright 2021 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <QString>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "wallet/core/common.h"
+#include "viewmodel/helpers/list_model.h"
+
+// Trigram index over the searchable text of transactions.
+// Texts are stored case folded, so candidates found through the
+// rarest trigram of a query are verified with a plain substring check.
+// Updated documents leave stale postings behind, they are dropped by
+// the verification and swept out once they outnumber the live ones.
+class TxSearchIndex
+{
+public:
+    using TxID    = beam::wallet::TxID;
+    using Matches = std::unordered_set<TxID, BlobKeyHash>;
+
+    void put(const TxID& id, const QString& text);
+    void remove(const TxID& id);
+    void clear();
+
+    // query must be case folded
+    [[nodiscard]] Matches find(const QString& query) const;
+    [[nodiscard]] bool matches(const TxID& id, const QString& query) const;
+
+private:
+    using Gram = quint64;
+
+    struct Doc
+    {
+        TxID id;
+        QString text;
+        bool alive = true;
+    };
+
+    static void collectGrams(const QString& text, std::vector<Gram>& grams);
+    void addPostings(uint32_t doc);
+    void compact();
+
+    std::vector<Doc> _docs;
+    std::unordered_map<TxID, uint32_t, BlobKeyHash> _docOf;
+    std::unordered_map<Gram, std::vector<uint32_t>> _postings;
+    size_t _dead = 0;
+};
@@ -15,9 +15,10 @@
 #include <QFileDialog>
 #include <QStandardPaths>
 #include <QDateTime>
-#include <QTextStream>
-#include <QTextCodec>
 #include <vector>
+#include <algorithm>
+#include <unordered_set>
+#include <limits>
 #include "model/app_model.h"
 
 namespace
@@ -25,16 +26,58 @@ namespace
     const char kTxHistoryFileNamePrefix[] = "transactions_history_";
     const char kTxHistoryFileFormatDesc[] = "Comma-Separated Values (*.csv)";
     const char kTxHistoryFileNameFormat[] = "yyyy_MM_dd_HH_mm_ss";
+
+    // TxObjects are built by pages, newest first
+    const size_t kPageSize = 100;
 }
 
 TxTableViewModel::TxTableViewModel()
     : _model(*AppModel::getInstance().getWalletModel())
+    , _txView(AppModel::getInstance().getTransactions()->makeView({
+        beam::wallet::TxType::Simple,
+        beam::wallet::TxType::PushTransaction,
+        beam::wallet::TxType::Contract,
+        beam::wallet::TxType::DexSimpleSwap}))
+    , _loadLimit(kPageSize)
 {
-    connect(&_model, SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)), SLOT(onTransactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)));
-    connect(&_model, SIGNAL(txHistoryExportedToCsv(const QString&)), this, SLOT(onTxHistoryExportedToCsv(const QString&)));
+    connect(_txView.get(), &TransactionsView::transactionsChanged, this, &TxTableViewModel::onTransactionsChanged);
+    connect(&_exporter, &TxHistoryExporter::runningChanged, this, &TxTableViewModel::exportChanged);
+    connect(&_exporter, &TxHistoryExporter::progressChanged, this, &TxTableViewModel::exportChanged);
+    connect(&_exporter, &TxHistoryExporter::failed, this, [this](const QString& path)
+    {
+        //: transactions history screen, export failed message
+        //% "Failed to export transactions history to %1"
+        emit exportFailed(qtTrId("wallet-export-tx-history-failed").arg(QDir::toNativeSeparators(path)));
+    });
     connect(&_exchangeRatesManager, &ExchangeRatesManager::rateUnitChanged, this, &TxTableViewModel::rateChanged);
     connect(&_exchangeRatesManager, &ExchangeRatesManager::activeRateChanged, this, &TxTableViewModel::rateChanged);
-    _model.getAsync()->getTransactions();
+
+    // rows keep display values of the second currency, rebuild them
+    connect(&_exchangeRatesManager, &ExchangeRatesManager::rateUnitChanged, this, &TxTableViewModel::reloadTransactions);
+
+    connect(&_transactionsList, &TxObjectList::fetchMoreRequested, this, &TxTableViewModel::fetchMoreTransactions);
+    connect(&_transactionsList, &TxObjectList::searchTextChanged, this, [this]()
+    {
+        if (!_transactionsList.getSearchText().isEmpty())
+        {
+            loadAllTransactions();
+        }
+    });
+
+    reloadTransactions();
+}
+
+void TxTableViewModel::reloadTransactions()
+{
+    auto store = AppModel::getInstance().getTransactions();
+    if (store->isLoaded())
+    {
+        onTransactionsChanged(beam::wallet::ChangeAction::Reset, store->getByType(_txView->types()));
+    }
+    else
+    {
+        store->load();
+    }
 }
 
 void TxTableViewModel::exportTxHistoryToCsv()
@@ -48,27 +91,35 @@ void TxTableViewModel::exportTxHistoryToCsv()
         QDir(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation))
             .filePath(kTxHistoryFileNamePrefix + now.toString(kTxHistoryFileNameFormat)), kTxHistoryFileFormatDesc);
 
-    if (!path.isEmpty())
+    if (path.isEmpty())
     {
-        _txHistoryToCsvPaths.enqueue(path);
-        _model.getAsync()->exportTxHistoryToCsv();
+        return;
     }
+
+    // snapshot of the history, the file itself is written on a worker thread
+    using namespace beam::wallet;
+    auto transactions = AppModel::getInstance().getTransactions()->getByType(_txView->types());
+    std::sort(transactions.begin(), transactions.end(), [](const TxDescription& left, const TxDescription& right)
+    {
+        return left.m_createTime > right.m_createTime;
+    });
+
+    _exporter.start(path, std::move(transactions));
 }
 
-void TxTableViewModel::onTxHistoryExportedToCsv(const QString& data)
+void TxTableViewModel::cancelExport()
 {
-    if (!_txHistoryToCsvPaths.isEmpty())
-    {
-        const auto& path = _txHistoryToCsvPaths.dequeue();
-        QFile file(path);
-        if (file.open(QIODevice::WriteOnly | QIODevice::Text))
-        {
-            QTextCodec *codec = QTextCodec::codecForName("UTF8");
-            QTextStream out(&file);
-            out.setCodec(codec);
-            out << data;
-        }
-    }
+    _exporter.cancel();
+}
+
+bool TxTableViewModel::isExportInProgress() const
+{
+    return _exporter.isRunning();
+}
+
+double TxTableViewModel::getExportProgress() const
+{
+    return _exporter.getProgress();
 }
 
 QAbstractItemModel* TxTableViewModel::getTransactions()
@@ -80,65 +131,65 @@ void TxTableViewModel::onTransactionsChanged(beam::wallet::ChangeAction action,
 {
     using namespace beam::wallet;
 
-    std::vector<std::shared_ptr<TxObject>> modifiedTransactions;
-    modifiedTransactions.reserve(transactions.size());
-    const auto secondCurrency = _exchangeRatesManager.getRateCurrency();
-
-    for (const auto& t : transactions)
+    if (action == ChangeAction::Reset)
     {
-        if(const auto txType = t.GetParameter<TxType>(TxParameterID::TransactionType))
-        {
-            switch(*txType)
-            {
-            case TxType::AtomicSwap:
-            case TxType::AssetIssue:
-            case TxType::AssetConsume:
-            case TxType::AssetReg:
-            case TxType::AssetUnreg:
-            case TxType::AssetInfo:
-            case TxType::PullTransaction:
-            case TxType::UnlinkFunds:
-            case TxType::VoucherRequest:
-            case TxType::VoucherResponse:
-                continue;
-
-            case TxType::ALL:
-                assert(!"This should not happen");
-                continue;
-
-            case TxType::Contract:
-            case TxType::PushTransaction:
-            case TxType::Simple:
-            case TxType::DexSimpleSwap:
-                modifiedTransactions.push_back(std::make_shared<TxObject>(t, secondCurrency));
-                break;
-            }
-        }
+        resetTransactions(transactions);
+        return;
     }
 
+    // the view passes displayed types only
+    const auto secondCurrency = _exchangeRatesManager.getRateCurrency();
+
     switch (action)
     {
-        case ChangeAction::Reset:
-            {
-                _transactionsList.reset(modifiedTransactions);
-                break;
-            }
-
         case ChangeAction::Removed:
             {
-                _transactionsList.remove(modifiedTransactions);
-                break;
-            }
+                std::vector<TxID> removedIDs;
+                removedIDs.reserve(transactions.size());
+                for (const auto& t : transactions)
+                {
+                    if (!erasePending(t.m_txId))
+                    {
+                        removedIDs.push_back(t.m_txId);
+                    }
+                }
+                _transactionsList.setCanFetchMore(!_pending.empty());
 
-        case ChangeAction::Added:
-            {
-                _transactionsList.insert(modifiedTransactions);
+                // nothing to build, but keep the order with batches in flight
+                _txBuilder.build({}, secondCurrency, [this, removedIDs = std::move(removedIDs)](TxObjectBuilder::Objects&&)
+                {
+                    _transactionsList.removeKeys(removedIDs);
+                    emit transactionsChanged();
+                });
                 break;
             }
 
+        case ChangeAction::Added:
         case ChangeAction::Updated:
             {
-                _transactionsList.update(modifiedTransactions);
+                // txs older than the loaded window wait for fetchMore, the store keeps their latest state
+                std::vector<TxDescription> loadedTransactions;
+                loadedTransactions.reserve(transactions.size());
+                for (const auto& t : transactions)
+                {
+                    if (_pendingTimes.count(t.m_txId))
+                    {
+                        continue;
+                    }
+                    if (_transactionsList.indexOf(t.m_txId) < 0 && !isInLoadedWindow(t))
+                    {
+                        addPending(t);
+                        continue;
+                    }
+                    loadedTransactions.push_back(t);
+                }
+                _transactionsList.setCanFetchMore(!_pending.empty());
+
+                _txBuilder.build(std::move(loadedTransactions), secondCurrency, [this](TxObjectBuilder::Objects&& modifiedTransactions)
+                {
+                    _transactionsList.update(modifiedTransactions);
+                    emit transactionsChanged();
+                });
                 break;
             }
 
@@ -146,8 +197,177 @@ void TxTableViewModel::onTransactionsChanged(beam::wallet::ChangeAction action,
             assert(false && "Unexpected action");
             break;
     }
+}
+
+void TxTableViewModel::resetTransactions(const std::vector<beam::wallet::TxDescription>& transactions)
+{
+    // Reset comes on every reconnect/rescan and usually carries the same history.
+    // Apply it as a diff so unchanged rows (and their delegates) are kept as is.
+    std::vector<const beam::wallet::TxDescription*> displayed;
+    displayed.reserve(transactions.size());
+    for (const auto& t : transactions)
+    {
+        displayed.push_back(&t);
+    }
+
+    // keep as many rows loaded as before, the rest waits for fetchMore
+    _pending.clear();
+    _pendingTimes.clear();
+    if (displayed.size() > _loadLimit)
+    {
+        const auto window = displayed.begin() + _loadLimit;
+        std::nth_element(displayed.begin(), window, displayed.end(), [](const auto* left, const auto* right)
+        {
+            return PendingKey(left->m_createTime, left->m_txId) > PendingKey(right->m_createTime, right->m_txId);
+        });
+        std::for_each(window, displayed.end(), [this](const auto* t) { addPending(*t); });
+        displayed.erase(window, displayed.end());
+    }
+    _transactionsList.setCanFetchMore(!_pending.empty());
+
+    std::unordered_set<beam::wallet::TxID, BlobKeyHash> keys;
+    keys.reserve(displayed.size());
+
+    std::vector<beam::wallet::TxDescription> modifiedTransactions;
+    const auto secondCurrency = _exchangeRatesManager.getRateCurrency();
 
-    emit transactionsChanged();
+    for (const auto* tx : displayed)
+    {
+        const auto& t = *tx;
+        keys.insert(t.m_txId);
+
+        const auto row = _transactionsList.indexOf(t.m_txId);
+        if (row < 0 || !_transactionsList.get(row)->isUpToDate(t, secondCurrency))
+        {
+            modifiedTransactions.push_back(t);
+        }
+    }
+
+    _txBuilder.build(std::move(modifiedTransactions), secondCurrency, [this, keys = std::move(keys)](TxObjectBuilder::Objects&& objects)
+    {
+        _transactionsList.retain(keys);
+        _transactionsList.insert(objects);
+        emit transactionsChanged();
+        emit transactionsLoaded();
+    });
+}
+
+void TxTableViewModel::fetchMoreTransactions()
+{
+    if (_loadLimit < std::numeric_limits<size_t>::max() - kPageSize)
+    {
+        _loadLimit += kPageSize;
+    }
+    loadPending(kPageSize);
+}
+
+void TxTableViewModel::loadAllTransactions()
+{
+    _loadLimit = std::numeric_limits<size_t>::max();
+    loadPending(_pending.size());
+
+    // batches are applied in order, this one lands after the rows above
+    _txBuilder.build({}, _exchangeRatesManager.getRateCurrency(), [this](TxObjectBuilder::Objects&&)
+    {
+        emit transactionsLoaded();
+    });
+}
+
+void TxTableViewModel::evictTransactions()
+{
+    _loadLimit = kPageSize;
+
+    const int count = _transactionsList.rowCount();
+    if (count <= static_cast<int>(kPageSize))
+    {
+        return;
+    }
+
+    std::vector<PendingKey> loaded;
+    loaded.reserve(count);
+    for (int row = 0; row < count; ++row)
+    {
+        const auto& tx = _transactionsList.get(row);
+        loaded.emplace_back(tx->timeCreated(), tx->getTxID());
+    }
+
+    const auto window = loaded.begin() + kPageSize;
+    std::nth_element(loaded.begin(), window, loaded.end(), std::greater<PendingKey>());
+
+    std::vector<beam::wallet::TxID> evicted;
+    evicted.reserve(loaded.end() - window);
+    for (auto it = window; it != loaded.end(); ++it)
+    {
+        addPending(it->first, it->second);
+        evicted.push_back(it->second);
+    }
+    _transactionsList.setCanFetchMore(true);
+
+    _txBuilder.build({}, _exchangeRatesManager.getRateCurrency(), [this, evicted = std::move(evicted)](TxObjectBuilder::Objects&&)
+    {
+        _transactionsList.removeKeys(evicted);
+        emit transactionsChanged();
+    });
+}
+
+void TxTableViewModel::loadPending(size_t count)
+{
+    auto store = AppModel::getInstance().getTransactions();
+
+    std::vector<beam::wallet::TxDescription> transactions;
+    transactions.reserve(std::min(count, _pending.size()));
+    while (count-- > 0 && !_pending.empty())
+    {
+        const auto it = std::prev(_pending.end());
+        if (const auto* tx = store->find(it->second))
+        {
+            transactions.push_back(*tx);
+        }
+        _pendingTimes.erase(it->second);
+        _pending.erase(it);
+    }
+    _transactionsList.setCanFetchMore(!_pending.empty());
+
+    _txBuilder.build(std::move(transactions), _exchangeRatesManager.getRateCurrency(), [this](TxObjectBuilder::Objects&& objects)
+    {
+        _transactionsList.insert(objects);
+        emit transactionsChanged();
+    });
+}
+
+void TxTableViewModel::addPending(const beam::wallet::TxDescription& tx)
+{
+    addPending(tx.m_createTime, tx.m_txId);
+}
+
+void TxTableViewModel::addPending(beam::Timestamp time, const beam::wallet::TxID& txId)
+{
+    if (_pendingTimes.emplace(txId, time).second)
+    {
+        _pending.emplace(time, txId);
+    }
+}
+
+bool TxTableViewModel::erasePending(const beam::wallet::TxID& txId)
+{
+    auto it = _pendingTimes.find(txId);
+    if (it == _pendingTimes.end())
+    {
+        return false;
+    }
+    _pending.erase(PendingKey(it->second, txId));
+    _pendingTimes.erase(it);
+    return true;
+}
+
+bool TxTableViewModel::isInLoadedWindow(const beam::wallet::TxDescription& tx) const
+{
+    return _pending.empty() || PendingKey(tx.m_createTime, tx.m_txId) > *_pending.rbegin();
+}
+
+int TxTableViewModel::getTotalCount() const
+{
+    return _transactionsList.rowCount() + static_cast<int>(_pending.size());
 }
 
 QString TxTableViewModel::getRateUnit() const
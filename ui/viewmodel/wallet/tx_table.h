@@ -14,10 +14,14 @@
 #pragma once
 
 #include <QObject>
-#include <QQueue>
 #include <QAbstractItemModel>
+#include <set>
+#include <unordered_map>
 #include "model/wallet_model.h"
+#include "model/transactions_store.h"
 #include "tx_object_list.h"
+#include "tx_object_builder.h"
+#include "tx_history_exporter.h"
 #include "viewmodel/notifications/exchange_rates_manager.h"
 
 class TxTableViewModel: public QObject {
@@ -25,6 +29,9 @@ class TxTableViewModel: public QObject {
     Q_PROPERTY(QAbstractItemModel*  transactions READ   getTransactions     NOTIFY transactionsChanged)
     Q_PROPERTY(QString rateUnit     READ getRateUnit    NOTIFY rateChanged)
     Q_PROPERTY(QString explorerUrl  READ getExplorerUrl CONSTANT)
+    Q_PROPERTY(int totalCount       READ getTotalCount  NOTIFY transactionsChanged)
+    Q_PROPERTY(bool exportInProgress READ isExportInProgress NOTIFY exportChanged)
+    Q_PROPERTY(double exportProgress READ getExportProgress  NOTIFY exportChanged)
 
 public:
     TxTableViewModel();
@@ -34,23 +41,52 @@ public:
     QString getRateUnit() const;
     QString getRate() const;
     QString getExplorerUrl() const;
+    int getTotalCount() const;
+    bool isExportInProgress() const;
+    double getExportProgress() const;
 
     Q_INVOKABLE void exportTxHistoryToCsv();
+    Q_INVOKABLE void cancelExport();
+    // search and sorting by other columns need the whole history
+    Q_INVOKABLE void loadAllTransactions();
+    // drops everything but the newest page, call when older rows are off screen
+    Q_INVOKABLE void evictTransactions();
     Q_INVOKABLE void cancelTx(const QVariant& variantTxID);
     Q_INVOKABLE void deleteTx(const QVariant& variantTxID);
     Q_INVOKABLE PaymentInfoItem* getPaymentInfo(const QVariant& variantTxID);
 
 public slots:
-    void onTxHistoryExportedToCsv(const QString& data);
     void onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items);
 
 signals:
     void transactionsChanged();
+    // a reset or loadAllTransactions() has been applied to the list
+    void transactionsLoaded();
     void rateChanged();
+    void exportChanged();
+    void exportFailed(const QString& message);
 
 private:
+    void reloadTransactions();
+    void resetTransactions(const std::vector<beam::wallet::TxDescription>& transactions);
+    void fetchMoreTransactions();
+    void loadPending(size_t count);
+    void addPending(const beam::wallet::TxDescription& tx);
+    void addPending(beam::Timestamp time, const beam::wallet::TxID& txId);
+    bool erasePending(const beam::wallet::TxID& txId);
+    bool isInLoadedWindow(const beam::wallet::TxDescription& tx) const;
+
     WalletModel&         _model;
-    QQueue<QString>      _txHistoryToCsvPaths;
+    TransactionsView::Ptr _txView;
     TxObjectList         _transactionsList;
     ExchangeRatesManager _exchangeRatesManager;
+    TxObjectBuilder      _txBuilder; // must be destroyed before the list
+    TxHistoryExporter    _exporter;
+
+    // displayed txs that have no TxObject yet, the newest is at the end.
+    // Descriptions stay in the transactions store, only keys are kept here
+    using PendingKey = std::pair<beam::Timestamp, beam::wallet::TxID>;
+    std::set<PendingKey> _pending;
+    std::unordered_map<beam::wallet::TxID, beam::Timestamp, BlobKeyHash> _pendingTimes;
+    size_t _loadLimit;
 };